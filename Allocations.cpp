@@ -0,0 +1,27 @@
+/**
+ * @file Allocations.cpp - implementation of Allocations
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include "Allocations.h"
+using namespace std;
+
+const char *const Allocations::NAMES[SUBSYSTEMS] = {"PixelMatrix", "ListA", "QueueA", "Critter"};
+
+atomic<bool> Allocations::enabled(false);
+Allocations::Counters Allocations::counters[SUBSYSTEMS];
+
+void Allocations::setEnabled(bool on) {
+    enabled.store(on, memory_order_relaxed);
+}
+
+Allocations::Counts Allocations::get(Subsystem subsystem) {
+    const Counters &c = counters[subsystem];
+    Counts counts;
+    counts.allocations = c.allocations.load(memory_order_relaxed);
+    counts.frees = c.frees.load(memory_order_relaxed);
+    counts.bytesAllocated = c.bytesAllocated.load(memory_order_relaxed);
+    counts.bytesFreed = c.bytesFreed.load(memory_order_relaxed);
+    return counts;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file Allocations.h - opt-in counts of memory allocated, by subsystem
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/**
+ * @class Allocations - how many allocations and frees, of how many bytes, each subsystem has done
+ *
+ * Counting is off until setEnabled(true); until then, each allocation just checks a
+ * flag. Turn it on before anything is allocated (first thing in main, say), or
+ * what was allocated before then will be freed without having been counted.
+ * The counts are kept with relaxed atomics, so allocating on any thread is fine.
+ *
+ * The subsystems count themselves: PixelMatrix in resize, ListA through its (default)
+ * CountingAllocator (or the chunks of an Arena it draws from), QueueA when it
+ * reallocates, and critters in CritterPool and its Arena.
+ */
+class Allocations {
+public:
+    /**
+     * @enum Subsystem - who is allocating
+     */
+    enum Subsystem {
+        PIXEL_MATRIX,   // pixel rows of PixelMatrix
+        LIST,           // ListA storage beyond its inline elements (unless it has its own allocator)
+        QUEUE,          // QueueA storage
+        CRITTER,        // the CritterPool's arena chunks, and critters too big to pool
+        SUBSYSTEMS      // number of subsystems
+    };
+    static const char *const NAMES[SUBSYSTEMS];
+
+    /**
+     * @struct Counts - what a subsystem has done (since counting was enabled)
+     */
+    struct Counts {
+        long allocations, frees;
+        long bytesAllocated, bytesFreed;
+
+        /**
+         * @return  bytes allocated and not yet freed
+         */
+        long getLiveBytes() const {
+            return bytesAllocated - bytesFreed;
+        }
+    };
+
+    /**
+     * @param on  true to start counting, false to stop (the counts so far are kept)
+     */
+    static void setEnabled(bool on);
+
+    /**
+     * @return  true if counting
+     */
+    static bool isEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Count allocations (if enabled).
+     *
+     * @param subsystem  who allocated
+     * @param bytes      how many bytes, altogether
+     * @param count      how many allocations
+     */
+    static void allocated(Subsystem subsystem, std::size_t bytes, long count = 1) {
+        if (isEnabled()) {
+            counters[subsystem].allocations.fetch_add(count, std::memory_order_relaxed);
+            counters[subsystem].bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Count frees (if enabled).
+     *
+     * @param subsystem  who freed
+     * @param bytes      how many bytes, altogether
+     * @param count      how many frees
+     */
+    static void freed(Subsystem subsystem, std::size_t bytes, long count = 1) {
+        if (isEnabled()) {
+            counters[subsystem].frees.fetch_add(count, std::memory_order_relaxed);
+            counters[subsystem].bytesFreed.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @param subsystem  which one
+     * @return           its counts so far
+     */
+    static Counts get(Subsystem subsystem);
+
+private:
+    struct Counters {
+        std::atomic<long> allocations, frees;
+        std::atomic<long> bytesAllocated, bytesFreed;
+    };
+
+    static std::atomic<bool> enabled;
+    static Counters counters[SUBSYSTEMS];
+};
+
+/**
+ * @class CountingAllocator<T,S> - standard allocator that counts what it does as subsystem S
+ * (see Allocations), and otherwise is std::allocator
+ */
+template <typename T, Allocations::Subsystem S>
+class CountingAllocator {
+public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind {
+        typedef CountingAllocator<U, S> other;
+    };
+
+    CountingAllocator() {}
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U, S> &) {}
+
+    T *allocate(std::size_t n) {
+        Allocations::allocated(S, n * sizeof(T));
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, std::size_t n) {
+        Allocations::freed(S, n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U, S> &) const { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U, S> &) const { return false; }
+};
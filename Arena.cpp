@@ -0,0 +1,63 @@
+/**
+ * @file Arena.cpp - implementation of Arena
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include "Arena.h"
+using namespace std;
+
+Arena::Arena(Allocations::Subsystem subsystem, size_t chunkSize)
+        : subsystem(subsystem), chunkSize(chunkSize), chunks(), current(0), offset(0), used(0) {
+}
+
+Arena::~Arena() {
+    for (Chunk &chunk: chunks) {
+        Allocations::freed(subsystem, chunk.size);
+        delete[] chunk.memory;
+    }
+}
+
+/*
+ * Try the current chunk, then any later ones (left over from before a reset), and
+ * only then get a new chunk from the heap (big enough for this allocation).
+ */
+void *Arena::allocate(size_t bytes, size_t align) {
+    for (; current < chunks.size(); current++, offset = 0) {
+        Chunk &chunk = chunks[current];
+        uintptr_t base = reinterpret_cast<uintptr_t>(chunk.memory);
+        size_t start = ((base + offset + align - 1) & ~(align - 1)) - base;
+        if (start + bytes <= chunk.size) {
+            offset = start + bytes;
+            used += bytes;
+            return chunk.memory + start;
+        }
+    }
+    Chunk chunk;
+    chunk.size = max(chunkSize, bytes + align);
+    chunk.memory = new char[chunk.size];
+    Allocations::allocated(subsystem, chunk.size);
+    chunks.push_back(chunk);
+    current = chunks.size() - 1;
+    offset = 0;
+    return allocate(bytes, align);
+}
+
+void Arena::reset() {
+    current = 0;
+    offset = 0;
+    used = 0;
+}
+
+size_t Arena::getBytesUsed() const {
+    return used;
+}
+
+size_t Arena::getBytesReserved() const {
+    size_t total = 0;
+    for (const Chunk &chunk: chunks)
+        total += chunk.size;
+    return total;
+}
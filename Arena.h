@@ -0,0 +1,106 @@
+/**
+ * @file Arena.h - bump allocator for memory that is all freed at once
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Allocations.h"
+
+/**
+ * @class Arena - hands out memory from big chunks and takes it all back at once
+ *
+ * Allocation is just bumping a pointer, and freeing individual allocations does
+ * nothing. reset() releases everything allocated so far in O(1) and keeps the
+ * chunks for reuse, so something like a per-frame arena reaches a steady state
+ * where it never goes to the heap.
+ */
+class Arena {
+public:
+    /**
+     * @param subsystem  who the chunks are counted as (see Allocations)
+     * @param chunkSize  bytes to get from the heap at a time
+     */
+    explicit Arena(Allocations::Subsystem subsystem, std::size_t chunkSize = 64 * 1024);
+
+    ~Arena();
+    Arena(const Arena &other) = delete;
+    Arena& operator=(const Arena &other) = delete;
+
+    /**
+     * Get some memory from the arena. It stays good until reset() or the arena is destroyed.
+     *
+     * @param bytes  number of bytes needed
+     * @param align  alignment needed (a power of two)
+     * @return       the memory
+     */
+    void *allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t));
+
+    /**
+     * Release everything allocated so far. Chunks are kept for reuse.
+     * Anything constructed in the arena must have been destroyed first.
+     */
+    void reset();
+
+    /**
+     * @return  bytes handed out since the last reset
+     */
+    std::size_t getBytesUsed() const;
+
+    /**
+     * @return  bytes held from the heap
+     */
+    std::size_t getBytesReserved() const;
+
+private:
+    struct Chunk {
+        char *memory;
+        std::size_t size;
+    };
+    Allocations::Subsystem subsystem;
+    std::size_t chunkSize;
+    std::vector<Chunk> chunks;
+    std::size_t current;    // index into chunks of the one we are allocating from
+    std::size_t offset;     // next free byte in chunks[current]
+    std::size_t used;
+};
+
+/**
+ * @class ArenaAllocator<T> - standard allocator interface to an Arena, e.g., for a ListA
+ * that is rebuilt every frame (the list must be gone before the arena is reset)
+ *
+ *     Arena frame(Allocations::LIST);
+ *     ListA<int, 0, ArenaAllocator<int>> scratch{ArenaAllocator<int>(frame)};
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    ArenaAllocator(Arena &arena) : arena(&arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.getArena()) {}
+
+    T *allocate(std::size_t n) {
+        return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T * /* p */, std::size_t /* n */) {
+        // nothing to do -- the arena takes everything back at once
+    }
+
+    Arena *getArena() const {
+        return arena;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> &other) const { return arena == other.getArena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const { return arena != other.getArena(); }
+
+private:
+    Arena *arena;
+};
@@ -0,0 +1,205 @@
+/**
+ * @file Autoplayer.cpp - implementation of Autoplayer
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include "Autoplayer.h"
+using namespace std;
+using chrono::steady_clock;
+
+Autoplayer::Autoplayer(Display &local, int apm, double sceneSeconds)
+        : local(local), actionsPerSecond(apm / 60.0), sceneSeconds(sceneSeconds), lastPaint(), painted(false),
+          budget(0), keys(), cannonCol(-1), heading(0), movesTyped(0), targetRow(-1), targetCol(-1), pace(0),
+          actions(0), shots(0) {
+    if (apm <= 0)
+        throw invalid_argument("bot must have positive actions per minute");
+    if (sceneSeconds < 0)
+        throw invalid_argument("scene time must not be negative");
+    keys.reserve(MAX_BURST);
+}
+
+void Autoplayer::getSize(int &rowCount, int &colCount) const {
+    local.getSize(rowCount, colCount);
+}
+
+int Autoplayer::getRowCount() const {
+    return local.getRowCount();
+}
+
+int Autoplayer::getColCount() const {
+    return local.getColCount();
+}
+
+void Autoplayer::paint(const PixelMatrix &pixels) {
+    local.paint(pixels);
+
+    // the time since the last scene buys actions (saved up only so far)
+    steady_clock::time_point now = steady_clock::now();
+    double elapsed = sceneSeconds;
+    if (sceneSeconds == 0)
+        elapsed = painted ? chrono::duration<double>(now - lastPaint).count() : 0;
+    lastPaint = now;
+    painted = true;
+    budget = min(budget + elapsed * actionsPerSecond, static_cast<double>(MAX_BURST));
+
+    // everything typed after the last scene has been done by now, so see which way the cannon went
+    int rows, cols;
+    pixels.getSize(rows, cols);
+    int cannon = findCannon(pixels, rows, cols);
+    if (cannon >= 0 && cannonCol >= 0 && movesTyped > 0 && cannon != cannonCol)
+        heading = cannon > cannonCol ? +1 : -1;
+    movesTyped = 0;
+    cannonCol = cannon;
+    if (cannon < 0) {
+        targetRow = -1;
+        return;  // nothing left to play with
+    }
+
+    // stick with the critter we were after if it's still around, else go after the lowest one
+    // (the one closest to getting the cannon; of those, the one nearest the cannon)
+    int top = rows - CANNON_ROWS;
+    int row = -1, col = -1;
+    if (targetRow >= 0) {
+        for (int r = max(0, targetRow - 2); r <= min(top - 1, targetRow + 2); r++) {
+            const RGB *line = pixels.getRow(r);
+            for (int c = max(0, targetCol - TRACKING); c <= min(cols - 1, targetCol + TRACKING); c++)
+                if (isCritter(line[c]) && (row < 0 || abs(c - targetCol) < abs(col - targetCol))) {
+                    row = r;
+                    col = c;
+                }
+        }
+    }
+    pace = row >= 0 ? (pace + col - targetCol) / 2 : 0;  // it goes by fits and starts, so smooth it out
+    for (int r = top - 1; r >= 0 && row < 0; r--) {
+        const RGB *line = pixels.getRow(r);
+        for (int c = 0; c < cols; c++)
+            if (isCritter(line[c]) && (row < 0 || abs(c - cannon) < abs(col - cannon))) {
+                row = r;
+                col = c;
+            }
+    }
+    targetRow = row;
+    targetCol = col;
+    if (row < 0)
+        return;  // nothing to shoot at
+
+    // intercept it: aim at the first spot along its way that the cannon can get under
+    // (at the actions a scene we can afford) in time for a ball to go up and meet it there;
+    // if it's getting away, wait at the side it's headed for, since it turns around there
+    double speed = actionsPerSecond * (sceneSeconds > 0 ? sceneSeconds : elapsed);
+    int flight = (top - row) / BALL_ROWS_PER_SCENE + 1;
+    int aim = pace > 0.5 ? cols - 1 : (pace < -0.5 ? 0 : col);
+    int wait = -1;  // scenes until it's time to shoot, or -1 if it's getting away
+    for (int t = 0; t <= cols; t++) {
+        int spot = col + static_cast<int>(lround(pace * (t + flight)));
+        if (spot < 0 || spot >= cols)
+            break;
+        if (abs(spot - cannon) <= speed * t + abs(pace) / 2) {
+            aim = spot;
+            wait = t;
+            break;
+        }
+    }
+
+    // line up under it and shoot when it's time (turning first, if need be, so moves come after any turn)
+    int at = cannon;
+    while (budget >= 1) {
+        if (abs(aim - at) <= 1) {  // close enough to hit some of it
+            if (wait == 0 && !ballInFlight(pixels, row, top)) {
+                type('i');
+                shots++;
+            }
+            break;
+        }
+        int way = aim > at ? +1 : -1;
+        if (heading == 0) {
+            type('h');  // see which way it goes
+            movesTyped++;
+            break;
+        }
+        if (heading != way) {
+            type('g');
+            heading = way;
+        } else {
+            type('h');
+            movesTyped++;
+            at += way;
+        }
+    }
+}
+
+bool Autoplayer::isBacklogged() const {
+    return local.isBacklogged();
+}
+
+void Autoplayer::setText(int r, int c, const string &text) {
+    local.setText(r, c, text);
+}
+
+bool Autoplayer::hasKey() const {
+    return local.hasKey() || !keys.empty();
+}
+
+int Autoplayer::getKey() {
+    if (local.hasKey())
+        return local.getKey();
+    if (keys.empty())
+        throw logic_error("no keypress available");
+    int c = keys.peek();
+    keys.dequeue();
+    return c;
+}
+
+void Autoplayer::pushbackKey(int c) {
+    local.pushbackKey(c);
+}
+
+const ListA<RGB>& Autoplayer::getColors() const {
+    return local.getColors();
+}
+
+long Autoplayer::getActionCount() const {
+    return actions;
+}
+
+long Autoplayer::getShotCount() const {
+    return shots;
+}
+
+void Autoplayer::type(int c) {
+    keys.enqueue(c);
+    actions++;
+    budget -= 1;
+}
+
+int Autoplayer::findCannon(const PixelMatrix &pixels, int rows, int cols) {
+    // its barrel is the one red pixel on its top row
+    for (int r = max(0, rows - CANNON_ROWS); r < rows; r++) {
+        const RGB *line = pixels.getRow(r);
+        for (int c = 0; c < cols; c++)
+            if (line[c] == RGB::RED)
+                return c;
+    }
+    return -1;
+}
+
+bool Autoplayer::ballInFlight(const PixelMatrix &pixels, int below, int above) {
+    int rows, cols;
+    pixels.getSize(rows, cols);
+    for (int r = below + 1; r < above; r++) {
+        const RGB *line = pixels.getRow(r);
+        for (int c = 0; c < cols; c++)
+            if (line[c] == RGB::MAGENTA)
+                return true;
+    }
+    return false;
+}
+
+bool Autoplayer::isCritter(const RGB &pixel) {
+    return !pixel.transparent && pixel != RGB::BLACK && pixel != RGB::MAGENTA;
+}
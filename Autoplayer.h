@@ -0,0 +1,152 @@
+/**
+ * @file Autoplayer.h - Display that plays the game by itself
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+#pragma once
+#include <chrono>
+#include "adt/Display.h"
+#include "QueueA.h"
+
+/**
+ * @class Autoplayer - Display decorator with a bot at the keyboard
+ *
+ * Everything is passed through to the local display (which can be a Headless one),
+ * but every scene painted is also looked at by the bot, which types 'h', 'g', and
+ * 'i' keystrokes the way a good player would: it goes after the lowest critter (the
+ * one closest to getting the cannon) until it's gone, leads it by how far it moves
+ * per scene, lines up the cannon under where it will be, and shoots, one cannonball
+ * at a time. Keys typed on the local display ('q', say) still work,
+ * and come ahead of the bot's.
+ *
+ * The bot only knows what it sees, so it works with any game on any display, and
+ * since its keystrokes go through the display, they are recorded like anyone's.
+ * For the same reason it can't play a game in a World bigger than the display:
+ * the critters up in the world are out of its sight.
+ *
+ * Its speed is limited to so many actions (keystrokes) per minute. The minutes can
+ * be real ones, or for headless games that run flat out, so many seconds a scene,
+ * which also makes what the bot does depend only on the scenes it is shown.
+ */
+class Autoplayer : public Display {
+public:
+    /**
+     * Put a bot at the keyboard.
+     *
+     * @param local         display to pass everything through to
+     * @param apm           actions (keystrokes) per minute
+     * @param sceneSeconds  time each scene painted counts as, or 0 to go by the clock
+     * @throws              invalid_argument if apm is not positive or sceneSeconds is negative
+     */
+    Autoplayer(Display &local, int apm, double sceneSeconds = 0);
+
+    void getSize(int &rowCount, int &colCount) const;
+    int getRowCount() const;
+    int getColCount() const;
+
+    /**
+     * Paint the local display, then let the bot look at the scene and decide what to type.
+     *
+     * @param pixels  the pixel map with the desired colors for each character cell
+     */
+    void paint(const PixelMatrix &pixels);
+
+    bool isBacklogged() const;
+    void setText(int r, int c, const std::string &text);
+
+    /**
+     * @return  true if a key was typed on the local display or by the bot
+     */
+    bool hasKey() const;
+
+    /**
+     * Get the next key typed on the local display, or if none, by the bot.
+     *
+     * @return  the key
+     * @throws  logic_error if there is no key waiting (or what the local display throws)
+     */
+    int getKey();
+
+    void pushbackKey(int c);
+    const ListA<RGB>& getColors() const;
+
+    /**
+     * @return  number of keystrokes the bot has typed
+     */
+    long getActionCount() const;
+
+    /**
+     * @return  number of those that were shots ('i')
+     */
+    long getShotCount() const;
+
+private:
+    /**
+     * most actions the bot saves up while it has nothing to do
+     */
+    static const int MAX_BURST = 4;
+
+    /**
+     * rows a cannonball goes up per scene (Menagerie moves everything three times a scene)
+     */
+    static const int BALL_ROWS_PER_SCENE = 3;
+
+    /**
+     * rows at the bottom of the display where the cannon is (the rest is where critters are)
+     */
+    static const int CANNON_ROWS = 3;
+
+    /**
+     * farthest a critter we're after can go from one scene to the next (in columns) and still be followed
+     */
+    static const int TRACKING = 8;
+
+    Display &local;
+    double actionsPerSecond;
+    double sceneSeconds;
+    std::chrono::steady_clock::time_point lastPaint;
+    bool painted;               // false until the first scene
+    double budget;              // actions the bot can take now
+
+    QueueA<int> keys;           // typed by the bot, not yet read
+    int cannonCol;              // where the cannon was in the last scene (-1 if not seen)
+    int heading;                // which way 'h' moves the cannon: +1, -1, or 0 if not known yet
+    int movesTyped;             // number of 'h's typed after the last scene
+    int targetRow, targetCol;   // critter we're after, as of the last scene (targetRow -1 if none)
+    double pace;                // columns it goes a scene (averaged), + for east
+    long actions, shots;
+
+    /**
+     * Type a key for the game to read.
+     *
+     * @param c  the key
+     */
+    void type(int c);
+
+    /**
+     * Find the cannon's barrel in the scene.
+     *
+     * @param pixels  the scene
+     * @param rows    number of rows in it
+     * @param cols    number of columns in it
+     * @return        column of the barrel, or -1 if there's no cannon
+     */
+    static int findCannon(const PixelMatrix &pixels, int rows, int cols);
+
+    /**
+     * Check if one of our cannonballs is still on its way up to a row
+     * (we shoot one at a time, since there are only so many).
+     *
+     * @param pixels  the scene
+     * @param below   row the ball has to be below
+     * @param above   row the ball has to be above (the top of the cannon)
+     * @return        true if there is one
+     */
+    static bool ballInFlight(const PixelMatrix &pixels, int below, int above);
+
+    /**
+     * @param pixel  pixel of the scene
+     * @return       true if it's part of a critter (not background or a cannonball)
+     */
+    static bool isCritter(const RGB &pixel);
+};
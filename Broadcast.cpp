@@ -0,0 +1,235 @@
+/**
+ * @file Broadcast.cpp - implementation of Broadcast display
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Broadcast.h"
+using namespace std;
+
+static Broadcast::Cell toCell(const RGB &px) {
+    Broadcast::Cell cell;
+    cell.red = px.red;
+    cell.green = px.green;
+    cell.blue = px.blue;
+    cell.flags = px.transparent ? 1 : 0;
+    return cell;
+}
+
+Broadcast::Broadcast(Display &local, const string &socketPath)
+        : local(local), path(socketPath), listener(-1), viewers(), previous(), frames(0), dropped(0) {
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path))
+        throw runtime_error("socket path too long: " + path);
+    strcpy(addr.sun_path, path.c_str());
+
+    listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listener < 0)
+        throw runtime_error("cannot create socket");
+    unlink(path.c_str());
+    if (bind(listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 || listen(listener, 16) < 0) {
+        close(listener);
+        throw runtime_error("cannot listen on " + path);
+    }
+}
+
+Broadcast::~Broadcast() {
+    for (Viewer &viewer: viewers)
+        close(viewer.fd);
+    close(listener);
+    unlink(path.c_str());
+}
+
+void Broadcast::getSize(int &rowCount, int &colCount) const {
+    local.getSize(rowCount, colCount);
+}
+
+int Broadcast::getRowCount() const {
+    return local.getRowCount();
+}
+
+int Broadcast::getColCount() const {
+    return local.getColCount();
+}
+
+/*
+ * Each frame is encoded at most twice (as a keyframe and as a delta), and only if
+ * some viewer is ready for that kind of message.
+ */
+void Broadcast::paint(const PixelMatrix &pixels) {
+    local.paint(pixels);
+    frames++;
+    acceptViewers();
+    if (viewers.empty()) {
+        previous = PixelMatrix();  // whoever connects next starts with a keyframe anyway
+        return;
+    }
+
+    int rows, cols, prows, pcols;
+    pixels.getSize(rows, cols);
+    previous.getSize(prows, pcols);
+    bool deltaOk = rows == prows && cols == pcols;
+
+    shared_ptr<string> keyframe, delta;
+    for (auto it = viewers.begin(); it != viewers.end(); ) {
+        Viewer &viewer = *it;
+        if (!flush(viewer)) {
+            close(viewer.fd);
+            it = viewers.erase(it);
+            continue;
+        }
+        if (viewer.outbox != nullptr) {
+            // lagging: finish the partial message (if any) before anything else, then resync
+            if (viewer.sent == 0)
+                viewer.outbox = nullptr;
+            dropped++;
+            viewer.needKeyframe = true;
+            ++it;
+            continue;
+        }
+        if (viewer.needKeyframe || !deltaOk) {
+            if (keyframe == nullptr) {
+                keyframe = make_shared<string>();
+                encodeKeyframe(pixels, *keyframe);
+            }
+            viewer.outbox = keyframe;
+        } else {
+            if (delta == nullptr) {
+                delta = make_shared<string>();
+                encodeDelta(pixels, *delta);
+            }
+            viewer.outbox = delta;
+        }
+        viewer.sent = 0;
+        viewer.needKeyframe = false;
+        if (!flush(viewer)) {
+            close(viewer.fd);
+            it = viewers.erase(it);
+            continue;
+        }
+        ++it;
+    }
+    previous = pixels;
+}
+
+void Broadcast::acceptViewers() {
+    int fd;
+    while ((fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+        Viewer viewer;
+        viewer.fd = fd;
+        viewer.outbox = nullptr;
+        viewer.sent = 0;
+        viewer.needKeyframe = true;
+        viewers.push_back(viewer);
+    }
+}
+
+/*
+ * Write as much of the outbox as the socket will take without blocking.
+ * Returns false if the viewer has gone away.
+ */
+bool Broadcast::flush(Viewer &viewer) {
+    if (viewer.outbox == nullptr)
+        return true;
+    const string &message = *viewer.outbox;
+    while (viewer.sent < message.size()) {
+        ssize_t n = send(viewer.fd, message.data() + viewer.sent, message.size() - viewer.sent,
+                         MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        viewer.sent += n;
+    }
+    viewer.outbox = nullptr;
+    viewer.sent = 0;
+    return true;
+}
+
+void Broadcast::encodeHeader(Kind kind, int rows, int cols, uint32_t cellCount, string &message) const {
+    MessageHeader header;
+    header.magic[0] = 'M';
+    header.magic[1] = 'F';
+    header.kind = kind;
+    header.unused = 0;
+    header.rows = static_cast<uint16_t>(rows);
+    header.cols = static_cast<uint16_t>(cols);
+    header.cellCount = cellCount;
+    header.frame = frames;
+    message.append(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+void Broadcast::encodeKeyframe(const PixelMatrix &pixels, string &message) const {
+    int rows, cols;
+    pixels.getSize(rows, cols);
+    message.reserve(sizeof(MessageHeader) + static_cast<size_t>(rows) * cols * sizeof(Cell));
+    encodeHeader(KEYFRAME, rows, cols, rows * cols, message);
+    for (int r = 0; r < rows; r++)
+        for (int c = 0; c < cols; c++) {
+            Cell cell = toCell(pixels.get(r, c));
+            message.append(reinterpret_cast<const char *>(&cell), sizeof(cell));
+        }
+}
+
+void Broadcast::encodeDelta(const PixelMatrix &pixels, string &message) const {
+    int rows, cols;
+    pixels.getSize(rows, cols);
+    encodeHeader(DELTA, rows, cols, 0, message);
+    uint32_t count = 0;
+    for (int r = 0; r < rows; r++)
+        for (int c = 0; c < cols; c++) {
+            const RGB &px = pixels.get(r, c);
+            if (px != previous.get(r, c)) {
+                Change change;
+                change.row = static_cast<uint16_t>(r);
+                change.col = static_cast<uint16_t>(c);
+                change.cell = toCell(px);
+                message.append(reinterpret_cast<const char *>(&change), sizeof(change));
+                count++;
+            }
+        }
+    // now that we know how many changes there are, fill that in
+    memcpy(&message[offsetof(MessageHeader, cellCount)], &count, sizeof(count));
+}
+
+bool Broadcast::isBacklogged() const {
+    return local.isBacklogged();
+}
+
+void Broadcast::setText(int r, int c, const string &text) {
+    local.setText(r, c, text);
+}
+
+bool Broadcast::hasKey() const {
+    return local.hasKey();
+}
+
+int Broadcast::getKey() {
+    return local.getKey();
+}
+
+void Broadcast::pushbackKey(int c) {
+    local.pushbackKey(c);
+}
+
+const ListA<RGB>& Broadcast::getColors() const {
+    return local.getColors();
+}
+
+int Broadcast::getViewerCount() const {
+    return static_cast<int>(viewers.size());
+}
+
+long Broadcast::getDroppedFrames() const {
+    return dropped;
+}
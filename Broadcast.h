@@ -0,0 +1,138 @@
+/**
+ * @file Broadcast.h - Display that also sends every frame to local spectators
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+#pragma once
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include "adt/Display.h"
+
+/**
+ * @class Broadcast - Display decorator that fans frames out to viewers on a Unix domain socket
+ *
+ * Everything is passed through to the local display (which can be a Headless one).
+ * In addition, any number of viewers can connect to the socket and each will be sent
+ * every painted frame. A frame is encoded at most once as a keyframe and once as a
+ * delta no matter how many viewers there are, and the same bytes are written to each.
+ *
+ * Writes never block. A viewer that hasn't taken all of the previous frame by the
+ * time the next one is painted is lagging: it misses frames until it has caught up,
+ * and then gets a keyframe. So a slow viewer never stalls the game or the others.
+ *
+ * Wire format, each message is a MessageHeader followed by:
+ *     KEYFRAME:  rows*cols Cells in row-major order
+ *     DELTA:     cellCount (row, col, Cell) changes from the previous frame
+ */
+class Broadcast : public Display {
+public:
+    /**
+     * @enum Kind - kinds of messages sent to viewers
+     */
+    enum Kind : std::uint8_t {
+        KEYFRAME = 1,
+        DELTA = 2
+    };
+
+    /**
+     * @struct Cell - one pixel on the wire (flags bit 0 is RGB::transparent)
+     */
+    struct Cell {
+        std::uint8_t red, green, blue, flags;
+    };
+
+    /**
+     * @struct Change - one changed pixel in a DELTA message
+     */
+    struct Change {
+        std::uint16_t row, col;
+        Cell cell;
+    };
+
+    /**
+     * @struct MessageHeader - start of each message
+     */
+    struct MessageHeader {
+        std::uint8_t magic[2];      // 'M', 'F'
+        std::uint8_t kind;          // a Kind
+        std::uint8_t unused;
+        std::uint16_t rows, cols;   // frame size
+        std::uint32_t cellCount;    // number of Cells (KEYFRAME) or Changes (DELTA) following
+        std::uint32_t frame;        // frame number, counting every paint
+    };
+
+    /**
+     * Start listening for viewers.
+     *
+     * @param local       display to pass everything through to
+     * @param socketPath  filesystem path for the Unix domain socket (replaced if it exists)
+     * @throws            runtime_error if the socket can't be set up
+     */
+    Broadcast(Display &local, const std::string &socketPath);
+
+    ~Broadcast();
+    Broadcast(const Broadcast &other) = delete;
+    Broadcast& operator=(const Broadcast &other) = delete;
+
+    void getSize(int &rowCount, int &colCount) const;
+    int getRowCount() const;
+    int getColCount() const;
+
+    /**
+     * Paint the local display, then send the frame to all the viewers.
+     * Also picks up any newly connected viewers.
+     *
+     * @param pixels  the pixel map with the desired colors for each character cell
+     */
+    void paint(const PixelMatrix &pixels);
+
+    /**
+     * Only the local display can be backlogged. Lagging viewers just miss frames.
+     *
+     * @return  true if the local display is backlogged
+     */
+    bool isBacklogged() const;
+
+    void setText(int r, int c, const std::string &text);
+    bool hasKey() const;
+    int getKey();
+    void pushbackKey(int c);
+    const ListA<RGB>& getColors() const;
+
+    /**
+     * @return  number of viewers currently connected
+     */
+    int getViewerCount() const;
+
+    /**
+     * @return  total number of frames viewers have missed because they were lagging
+     */
+    long getDroppedFrames() const;
+
+private:
+    /**
+     * @struct Viewer - a connected spectator
+     */
+    struct Viewer {
+        int fd;
+        std::shared_ptr<const std::string> outbox;  // message being sent (shared by all viewers), or nullptr
+        std::size_t sent;       // bytes of outbox already written
+        bool needKeyframe;      // true if next message must be a keyframe
+    };
+
+    Display &local;
+    std::string path;
+    int listener;
+    std::list<Viewer> viewers;
+    PixelMatrix previous;       // last frame sent, for computing deltas
+    std::uint32_t frames;
+    long dropped;
+
+    void acceptViewers();
+    bool flush(Viewer &viewer);
+    void encodeKeyframe(const PixelMatrix &pixels, std::string &message) const;
+    void encodeDelta(const PixelMatrix &pixels, std::string &message) const;
+    void encodeHeader(Kind kind, int rows, int cols, std::uint32_t cellCount, std::string &message) const;
+};
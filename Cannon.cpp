@@ -5,12 +5,23 @@
  */
 
 #include "Cannon.h"
+#include "Shape.h"
+#include "Snapshot.h"
 
 using namespace std;
 
+// red pyramid on its base at (r,c)
+static constexpr Shape<4> SHAPE = makeShape<4>({
+    {0, -1, ShapePixel::RED}, {0, 0, ShapePixel::RED}, {0, 1, ShapePixel::RED}, {-1, 0, ShapePixel::RED}});
+static_assert(SHAPE.bounds.top == -1 && SHAPE.bounds.left == -1 && SHAPE.bounds.right == 1, "3 wide, 2 high");
+
 Cannon::Cannon(int row, int col) : heading(EAST), r(row), c(col) {
 }
 
+Cannon::Cannon(const Critter::State &state)
+        : heading(state.heading == WEST ? WEST : EAST), r(state.row), c(state.col) {
+}
+
 void Cannon::move() {
     c += sign();
 }
@@ -30,8 +41,28 @@ int Cannon::sign() const {
 }
 
 void Cannon::render(PixelMatrix &pxm) const {
-    pxm.paint(r, c - 1, r, c + 1, RGB::RED);
-    pxm.paint(r - 1, c, RGB::RED);
+    SHAPE.render(pxm, r, c);
+}
+
+void Cannon::renderClipped(PixelMatrix &pxm, int top, int left, int bottom, int right) const {
+    SHAPE.render(pxm, r, c, top, left, bottom, right);
+}
+
+bool Cannon::getBounds(int &top, int &left, int &bottom, int &right) const {
+    top = r + SHAPE.bounds.top;
+    left = c + SHAPE.bounds.left;
+    bottom = r + SHAPE.bounds.bottom;
+    right = c + SHAPE.bounds.right;
+    return true;
+}
+
+bool Cannon::getState(Critter::State &state) const {
+    state = Critter::State();
+    state.kind = Snapshot::CANNON;
+    state.heading = heading;
+    state.row = r;
+    state.col = c;
+    return true;
 }
 
 Critter::Direction Cannon::getHeading() const {
@@ -20,11 +20,21 @@ class Cannon : public Critter {
 public:
     Cannon(int row, int col);
 
+    /**
+     * Make a Cannon back from its state (see Snapshot::make).
+     *
+     * @param state  from getState
+     */
+    explicit Cannon(const Critter::State &state);
+
     void move();
     void reverse();
     void rotate();
 
     void render(PixelMatrix &pxm) const;
+    void renderClipped(PixelMatrix &pxm, int top, int left, int bottom, int right) const;
+    bool getBounds(int &top, int &left, int &bottom, int &right) const;
+    bool getState(Critter::State &state) const;
     Critter::Direction getHeading() const;
     int getColumn() const;
 
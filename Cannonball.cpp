@@ -5,11 +5,19 @@
  */
 
 #include "Cannonball.h"
+#include "Shape.h"
+#include "Snapshot.h"
 using namespace std;
 
+// one magenta pixel just above (r,c)
+static constexpr Shape<1> SHAPE = makeShape<1>({{-1, 0, ShapePixel::MAGENTA}});
+
 Cannonball::Cannonball(int row, int col) : r(row), c(col) {
 }
 
+Cannonball::Cannonball(const Critter::State &state) : r(state.row), c(state.col) {
+}
+
 void Cannonball::move() {
     r -= 1;
 }
@@ -21,7 +29,26 @@ void Cannonball::rotate() {
 }
 
 void Cannonball::render(PixelMatrix &pxm) const {
-    pxm.paint(r-1, c, RGB::MAGENTA);
+    SHAPE.render(pxm, r, c);
+}
+
+void Cannonball::renderClipped(PixelMatrix &pxm, int top, int left, int bottom, int right) const {
+    SHAPE.render(pxm, r, c, top, left, bottom, right);
+}
+
+bool Cannonball::getBounds(int &top, int &left, int &bottom, int &right) const {
+    top = bottom = r + SHAPE.bounds.top;
+    left = right = c + SHAPE.bounds.left;
+    return true;
+}
+
+bool Cannonball::getState(Critter::State &state) const {
+    state = Critter::State();
+    state.kind = Snapshot::CANNONBALL;
+    state.heading = NORTH;
+    state.row = r;
+    state.col = c;
+    return true;
 }
 
 Critter::Direction Cannonball::getHeading() const {
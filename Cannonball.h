@@ -19,11 +19,21 @@ class Cannonball : public Critter {
 public:
     Cannonball(int row, int col);
 
+    /**
+     * Make a Cannonball back from its state (see Snapshot::make).
+     *
+     * @param state  from getState
+     */
+    explicit Cannonball(const Critter::State &state);
+
     void move();
     void reverse();
     void rotate();
 
     void render(PixelMatrix &pxm) const;
+    void renderClipped(PixelMatrix &pxm, int top, int left, int bottom, int right) const;
+    bool getBounds(int &top, int &left, int &bottom, int &right) const;
+    bool getState(Critter::State &state) const;
     Critter::Direction getHeading() const;
     int getColumn() const;
 
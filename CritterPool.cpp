@@ -0,0 +1,88 @@
+/**
+ * @file CritterPool.cpp - implementation of CritterPool
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <new>
+#include "Allocations.h"
+#include "CritterPool.h"
+using namespace std;
+
+CritterPool& CritterPool::instance() {
+    static CritterPool pool;
+    return pool;
+}
+
+CritterPool::CritterPool() : arena(Allocations::CRITTER), freeLists(), freeCounts(), live(0) {
+}
+
+int CritterPool::sizeClass(size_t bytes) {
+    return bytes == 0 ? 0 : static_cast<int>((bytes - 1) / GRANULE);
+}
+
+size_t CritterPool::getBlockSize(size_t bytes) {
+    return (sizeClass(bytes) + 1) * GRANULE;
+}
+
+void *CritterPool::allocate(size_t bytes) {
+    live++;
+    if (bytes > MAX_POOLED) {
+        Allocations::allocated(Allocations::CRITTER, bytes);
+        return ::operator new(bytes);
+    }
+    int k = sizeClass(bytes);
+    FreeBlock *block = freeLists[k];
+    if (block != nullptr) {
+        freeLists[k] = block->next;
+        freeCounts[k]--;
+        return block;
+    }
+    return arena.allocate((k + 1) * GRANULE, GRANULE);
+}
+
+void CritterPool::deallocate(void *p, size_t bytes) {
+    if (p == nullptr)
+        return;
+    live--;
+    if (bytes > MAX_POOLED) {
+        Allocations::freed(Allocations::CRITTER, bytes);
+        ::operator delete(p);
+        return;
+    }
+    int k = sizeClass(bytes);
+    FreeBlock *block = static_cast<FreeBlock *>(p);
+    block->next = freeLists[k];
+    freeLists[k] = block;
+    freeCounts[k]++;
+}
+
+void CritterPool::reserve(size_t bytes, int count) {
+    if (bytes > MAX_POOLED)
+        return;
+    int k = sizeClass(bytes);
+    for (; freeCounts[k] < count; freeCounts[k]++) {
+        FreeBlock *block = static_cast<FreeBlock *>(arena.allocate((k + 1) * GRANULE, GRANULE));
+        block->next = freeLists[k];
+        freeLists[k] = block;
+    }
+}
+
+bool CritterPool::reset() {
+    if (live != 0)
+        return false;
+    for (int k = 0; k < CLASSES; k++) {
+        freeLists[k] = nullptr;
+        freeCounts[k] = 0;
+    }
+    arena.reset();
+    return true;
+}
+
+int CritterPool::getLiveCount() const {
+    return live;
+}
+
+size_t CritterPool::getBytesReserved() const {
+    return arena.getBytesReserved();
+}
@@ -0,0 +1,120 @@
+/**
+ * @file CritterPool.h - memory pool that every Critter is allocated from
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <cstddef>
+#include "Arena.h"
+
+/**
+ * @class CritterPool - size-class free lists on top of an Arena
+ *
+ * Critter's operator new and operator delete come here, so every kind of critter
+ * (Cannon, Cannonball, InchWorm, ...) is pooled without doing anything itself.
+ * Each size (rounded up to GRANULE bytes) has its own free list: allocate pops
+ * from it or else bumps the arena, and deallocate pushes back on it, both O(1).
+ * Once no critters are alive, reset() hands everything back to the arena at once,
+ * so a game can start from a compact pool. Objects bigger than MAX_POOLED bytes go
+ * to the general heap.
+ *
+ * Not thread-safe, and the pool is a process-wide singleton: critters must be
+ * created and destroyed on the game loop's thread only. In particular, moves run
+ * on worker threads (see WorkerPool), so a critter must not create or delete other
+ * critters inside move() -- nothing here would stop the race.
+ */
+class CritterPool {
+public:
+    /**
+     * sizes are rounded up to a multiple of this (also the alignment of every object)
+     */
+    static const std::size_t GRANULE = alignof(std::max_align_t);
+
+    /**
+     * biggest object that is pooled
+     */
+    static const std::size_t MAX_POOLED = 16 * GRANULE;
+
+    /**
+     * @return  the pool that Critter::operator new uses
+     */
+    static CritterPool& instance();
+
+    CritterPool();
+    ~CritterPool() = default;
+    CritterPool(const CritterPool &other) = delete;
+    CritterPool& operator=(const CritterPool &other) = delete;
+
+    /**
+     * Get memory for an object.
+     *
+     * @param bytes  size of the object
+     * @return       the memory
+     * @throws       bad_alloc if the heap is exhausted
+     */
+    void *allocate(std::size_t bytes);
+
+    /**
+     * Give back memory from allocate.
+     *
+     * @param p      memory from allocate (or nullptr, which does nothing)
+     * @param bytes  the same size given to allocate
+     */
+    void deallocate(void *p, std::size_t bytes);
+
+    /**
+     * Top up the free list for objects of this size to at least count blocks up
+     * front, so allocating that many later doesn't have to go to the arena (or the
+     * heap). Only the shortfall is added, so reserving the same again (say, for each
+     * new game) takes no more memory. Sizes with the same getBlockSize share a free
+     * list. Does nothing for objects bigger than MAX_POOLED.
+     *
+     * @param bytes  size of the objects
+     * @param count  number of them
+     * @throws       bad_alloc if the heap is exhausted
+     */
+    void reserve(std::size_t bytes, int count);
+
+    /**
+     * @param bytes  size of an object
+     * @return       size of the block it is given (bytes rounded up to a multiple of GRANULE)
+     */
+    static std::size_t getBlockSize(std::size_t bytes);
+
+    /**
+     * Release all the pooled memory back to the arena in one go (the arena keeps its
+     * chunks, so nothing goes back to the heap). Only possible when no objects from
+     * this pool are alive.
+     *
+     * @return  true if the pool was reset, false (and nothing done) if objects are still alive
+     */
+    bool reset();
+
+    /**
+     * @return  number of objects allocated and not yet deallocated
+     */
+    int getLiveCount() const;
+
+    /**
+     * @return  bytes held from the heap by the arena
+     */
+    std::size_t getBytesReserved() const;
+
+private:
+    static const int CLASSES = MAX_POOLED / GRANULE;
+
+    /**
+     * @struct FreeBlock - a block on a free list (overlays the dead object's memory)
+     */
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    Arena arena;
+    FreeBlock *freeLists[CLASSES];  // freeLists[k] holds blocks of (k+1)*GRANULE bytes
+    int freeCounts[CLASSES];        // number of blocks on freeLists[k]
+    int live;
+
+    static int sizeClass(std::size_t bytes);
+};
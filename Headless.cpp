@@ -0,0 +1,66 @@
+/**
+ * @file Headless.cpp - implementation of Headless display
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <stdexcept>
+#include "Headless.h"
+using namespace std;
+
+Headless::Headless(int rowCount, int colCount) : rows(rowCount), cols(colCount), paints(0), keys(), colors() {
+    if (rows <= 0 || cols <= 0)
+        throw invalid_argument("headless display must have positive dimensions");
+    const RGB *standard[] = {&RGB::BLACK, &RGB::RED, &RGB::GREEN, &RGB::YELLOW,
+                             &RGB::BLUE, &RGB::MAGENTA, &RGB::CYAN, &RGB::WHITE};
+    for (const RGB *color: standard)
+        colors.append(*color);
+}
+
+void Headless::getSize(int &rowCount, int &colCount) const {
+    rowCount = rows;
+    colCount = cols;
+}
+
+int Headless::getRowCount() const {
+    return rows;
+}
+
+int Headless::getColCount() const {
+    return cols;
+}
+
+void Headless::paint(const PixelMatrix &) {
+    paints++;
+}
+
+void Headless::setText(int, int, const string &) {
+}
+
+bool Headless::hasKey() const {
+    return !keys.empty();
+}
+
+int Headless::getKey() {
+    if (keys.empty())
+        throw logic_error("no keypress available");
+    int c = keys.front();
+    keys.pop_front();
+    return c;
+}
+
+void Headless::pushbackKey(int c) {
+    keys.push_front(c);
+}
+
+void Headless::typeKey(int c) {
+    keys.push_back(c);
+}
+
+const ListA<RGB>& Headless::getColors() const {
+    return colors;
+}
+
+long Headless::getPaintCount() const {
+    return paints;
+}
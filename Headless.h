@@ -0,0 +1,84 @@
+/**
+ * @file Headless.h - display with no screen, for replays, benchmarks, and bots
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+#pragma once
+#include <deque>
+#include "adt/Display.h"
+
+/**
+ * @class Headless - Display implementation that doesn't show anything
+ *
+ * Has a fixed size given at construction. Painting just counts the paints.
+ * Keys are only what gets put there with pushbackKey or typeKey, so the
+ * game runs at full speed without a terminal attached.
+ */
+class Headless : public Display {
+public:
+    /**
+     * Construct a headless display of the given size.
+     *
+     * @param rowCount  number of rows
+     * @param colCount  number of columns
+     * @throws          invalid_argument if either dimension is not positive
+     */
+    Headless(int rowCount = 24, int colCount = 80);
+
+    void getSize(int &rowCount, int &colCount) const;
+    int getRowCount() const;
+    int getColCount() const;
+
+    /**
+     * Doesn't show anything, but counts the paint.
+     *
+     * @param pixels  ignored
+     */
+    void paint(const PixelMatrix &pixels);
+
+    /**
+     * Doesn't show anything.
+     */
+    void setText(int r, int c, const std::string &text);
+
+    bool hasKey() const;
+
+    /**
+     * Get the next key that was pushed back or typed.
+     * Never blocks.
+     *
+     * @return  the key
+     * @throws  logic_error if there is no key waiting
+     */
+    int getKey();
+
+    void pushbackKey(int c);
+
+    /**
+     * Simulate a key being typed. Unlike pushbackKey, this goes onto the end of the
+     * input queue, i.e., it is read after any keys already waiting.
+     *
+     * @param c  key to add to the input
+     */
+    void typeKey(int c);
+
+    /**
+     * The colors are the eight fully-saturated ones from RGB.
+     *
+     * @return  list of the supported colors
+     */
+    const ListA<RGB>& getColors() const;
+
+    /**
+     * Get the number of times paint has been called.
+     *
+     * @return  paint count
+     */
+    long getPaintCount() const;
+
+private:
+    int rows, cols;
+    long paints;
+    std::deque<int> keys;
+    ListA<RGB> colors;
+};
@@ -0,0 +1,93 @@
+/**
+ * @file Histogram.h - log-scale histogram of durations
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <cmath>
+
+/**
+ * @struct Histogram - how many times something took how long, in log-scale buckets
+ *
+ * counts[0] is how many took under a microsecond. Past that, each power of two
+ * (1-2us, 2-4us, ...) is split into SUBBUCKETS equal buckets, so a bucket is at
+ * most 1/SUBBUCKETS of its octave wide (the last bucket also has everything longer).
+ * Adding is a few instructions and never allocates, so it can go in a hot loop.
+ * A Histogram with all zero counts (e.g., Histogram h = {}) is empty.
+ */
+struct Histogram {
+    static const int SUBBUCKETS = 8;                    // buckets per power of two
+    static const int OCTAVES = 31;                      // the last one starts at about 18 minutes
+    static const int BUCKETS = 1 + OCTAVES * SUBBUCKETS;
+
+    long counts[BUCKETS];
+
+    /**
+     * Count one more duration.
+     *
+     * @param seconds  how long it took
+     */
+    void add(double seconds) {
+        double micros = seconds * 1e6;
+        int b = 0;
+        if (micros >= 1) {
+            int exponent;
+            double fraction = std::frexp(micros, &exponent);  // micros = fraction * 2^exponent, 0.5 <= fraction < 1
+            b = 1 + (exponent - 1) * SUBBUCKETS + static_cast<int>((2 * fraction - 1) * SUBBUCKETS);
+            if (b >= BUCKETS)
+                b = BUCKETS - 1;
+        }
+        counts[b]++;
+    }
+
+    /**
+     * @return  number of durations counted
+     */
+    long getCount() const {
+        long n = 0;
+        for (long count: counts)
+            n += count;
+        return n;
+    }
+
+    /**
+     * Estimate a percentile, e.g., percentile(0.99) is about as long as 99% of the
+     * durations counted, by interpolating linearly within the bucket it falls in.
+     * Anything in the first bucket is reported as 0, since it is all too short to
+     * tell apart (interpolating would make a phase that always takes a few
+     * nanoseconds look like it takes up to a microsecond).
+     *
+     * @param fraction  percentile as a fraction, from 0 to 1
+     * @return          the duration, in seconds (0 if empty)
+     */
+    double percentile(double fraction) const {
+        long n = getCount();
+        if (n == 0)
+            return 0;
+        double target = fraction * n;
+        long seen = 0;
+        for (int b = 0; b < BUCKETS; b++) {
+            if (counts[b] > 0 && seen + counts[b] >= target) {
+                if (b == 0)
+                    return 0;
+                double low = bottom(b), high = bottom(b + 1);
+                double within = (target - seen) / counts[b];
+                return (low + (high - low) * (within > 0 ? within : 0)) * 1e-6;
+            }
+            seen += counts[b];
+        }
+        return bottom(BUCKETS) * 1e-6;
+    }
+
+    /**
+     * @param b  bucket number (BUCKETS for the top of the last one)
+     * @return   shortest duration that goes in it, in microseconds
+     */
+    static double bottom(int b) {
+        if (b == 0)
+            return 0;
+        int octave = (b - 1) / SUBBUCKETS, sub = (b - 1) % SUBBUCKETS;
+        return std::ldexp(1.0 + static_cast<double>(sub) / SUBBUCKETS, octave);
+    }
+};
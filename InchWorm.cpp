@@ -5,6 +5,8 @@
  */
 
 #include "InchWorm.h"
+#include "Shape.h"
+#include "Snapshot.h"
 #include <iostream>
 using namespace std;
 
@@ -15,6 +17,13 @@ InchWorm::InchWorm(int row, int col) {
   heading = EAST;
 }
 
+InchWorm::InchWorm(const Critter::State &saved) {
+  r = saved.row;
+  c = saved.col;
+  state = saved.phase == BUNCHED ? BUNCHED : STRAIGHT;
+  heading = static_cast<Direction>(saved.heading);
+}
+
 void InchWorm:: move() {
   if(state == STRAIGHT) {
     state = BUNCHED;
@@ -67,95 +76,50 @@ void InchWorm:: rotate() {
   }
 }
 
-void InchWorm:: render(PixelMatrix &pxm) const {
-  pxm.paint(r, c, RGB:: WHITE);
-  RGB color;
-  int rows, cols;
-  pxm.getSize(rows,cols);
-  if(state == STRAIGHT) {
-    if(heading == EAST) {
-      for(int i = 0; i <7; i++) {
-        if(i%2==0) {
-          pxm.paint(r,c-i,RGB::WHITE);
-        }
-        if(i%2!=0) {
-          pxm.paint(r,c-i,RGB::GREEN);
-        }
-      }
-    }
+// EASTbound shapes, relative to the head at (r,c)
+static constexpr ShapePixel::Ink WHITE = ShapePixel::WHITE, GREEN = ShapePixel::GREEN;
+static constexpr Shape<7> STRAIGHT_EAST = makeShape<7>({
+  {0,0,WHITE}, {0,-1,GREEN}, {0,-2,WHITE}, {0,-3,GREEN}, {0,-4,WHITE}, {0,-5,GREEN}, {0,-6,WHITE}});
+static constexpr Shape<7> BUNCHED_EAST = makeShape<7>({
+  {0,0,WHITE}, {0,-1,GREEN}, {-1,-1,WHITE}, {-1,-2,GREEN}, {-1,-3,WHITE}, {0,-3,GREEN}, {0,-4,WHITE}});
+
+// every pose, turned at compile time: POSES[state][heading]
+static constexpr Shape<7> POSES[2][4] = {
+  {STRAIGHT_EAST.facing(Critter::NORTH), STRAIGHT_EAST.facing(Critter::SOUTH),
+   STRAIGHT_EAST.facing(Critter::EAST), STRAIGHT_EAST.facing(Critter::WEST)},
+  {BUNCHED_EAST.facing(Critter::NORTH), BUNCHED_EAST.facing(Critter::SOUTH),
+   BUNCHED_EAST.facing(Critter::EAST), BUNCHED_EAST.facing(Critter::WEST)}};
+
+static_assert(POSES[0][Critter::NORTH].bounds.bottom == 6, "straight northbound tail is 6 below the head");
+static_assert(POSES[1][Critter::EAST].bounds.top == -1, "bunched eastbound hump is 1 above the head");
+static_assert(POSES[1][Critter::SOUTH].bounds.left == -1 && POSES[1][Critter::SOUTH].bounds.top == -4,
+              "bunched southbound hump is to the west, tail is 4 above the head");
 
-    if(heading == WEST) {
-      for(int i = 0; i <7; i++) {
-        if(i%2==0) {
-          pxm.paint(r,c+i,RGB::WHITE);
-        }
-        if(i%2!=0) {
-          pxm.paint(r,c+i,RGB::GREEN);
-        }
-      }
-    }
-
-    if(heading == NORTH) {
-      for(int i = 0; i <7; i++) {
-        if(i%2==0) {
-          pxm.paint(r+i,c,RGB::WHITE);
-        }
-        if(i%2!=0) {
-          pxm.paint(r+i,c,RGB::GREEN);
-        }
-      }
-    }
-
-    if(heading == SOUTH) {
-      for(int i = 0; i <7; i++) {
-        if(i%2==0) {
-          pxm.paint(r-i,c,RGB::WHITE);
-        }
-        if(i%2!=0) {
-          pxm.paint(r-i,c,RGB::GREEN);
-        }
-      }
-    }
-
-    
-  } 
-  else if(state == BUNCHED) {
-    if(heading == EAST) {
-      pxm.paint(r,c-1,RGB::GREEN);
-      pxm.paint(r-1,c-1,RGB::WHITE);
-      pxm.paint(r-1,c-2,RGB::GREEN);
-      pxm.paint(r-1,c-3,RGB::WHITE);
-      pxm.paint(r,c-3,RGB::GREEN);
-      pxm.paint(r,c-4,RGB::WHITE);
-    }
-    else if(heading == WEST) {
-      pxm.paint(r,c+1,RGB::GREEN);
-      pxm.paint(r-1,c+1,RGB::WHITE);
-      pxm.paint(r-1,c+2,RGB::GREEN);
-      pxm.paint(r-1,c+3,RGB::WHITE);
-      pxm.paint(r,c+3,RGB::GREEN);
-      pxm.paint(r,c+4,RGB::WHITE);
+void InchWorm:: render(PixelMatrix &pxm) const {
+  POSES[state][heading].render(pxm, r, c);
+}
 
-    }
-    else if(heading == NORTH) {
-      pxm.paint(r+1,c,RGB::GREEN);
-      pxm.paint(r+1,c-1,RGB::WHITE);
-      pxm.paint(r+2,c-1,RGB::GREEN);
-      pxm.paint(r+3,c-1,RGB::WHITE);
-      pxm.paint(r+3,c,RGB::GREEN);
-      pxm.paint(r+4,c,RGB::WHITE);
-    }
-    else if(heading == SOUTH) {
-      pxm.paint(r-1,c,RGB::GREEN);
-      pxm.paint(r-1,c-1,RGB::WHITE);
-      pxm.paint(r-2,c-1,RGB::GREEN);
-      pxm.paint(r-3,c-1,RGB::WHITE);
-      pxm.paint(r-3,c,RGB::GREEN);
-      pxm.paint(r-4,c,RGB::WHITE);
+void InchWorm::renderClipped(PixelMatrix &pxm, int top, int left, int bottom, int right) const {
+  POSES[state][heading].render(pxm, r, c, top, left, bottom, right);
+}
 
+bool InchWorm::getBounds(int &top, int &left, int &bottom, int &right) const {
+  const ShapeBounds &b = POSES[state][heading].bounds;
+  top = r + b.top;
+  left = c + b.left;
+  bottom = r + b.bottom;
+  right = c + b.right;
+  return true;
+}
 
-    }
-  }
+bool InchWorm::getState(Critter::State &saved) const {
+  saved = Critter::State();
+  saved.kind = Snapshot::INCHWORM;
+  saved.heading = heading;
+  saved.phase = state;
+  saved.row = r;
+  saved.col = c;
+  return true;
 }
 
 int InchWorm::sign() const {
@@ -25,11 +25,21 @@ public:
      */
     InchWorm(int row, int col);
 
+    /**
+     * Make an InchWorm back from its state (see Snapshot::make).
+     *
+     * @param saved  from getState
+     */
+    explicit InchWorm(const Critter::State &saved);
+
     void move();
     void reverse();
     void rotate();
 
     void render(PixelMatrix &pxm) const;
+    void renderClipped(PixelMatrix &pxm, int top, int left, int bottom, int right) const;
+    bool getBounds(int &top, int &left, int &bottom, int &right) const;
+    bool getState(Critter::State &saved) const;
     Critter::Direction getHeading() const;
     int getColumn() const;
 
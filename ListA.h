@@ -5,8 +5,49 @@
  */
 #pragma once
 #include <iostream>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <cstring>
+#include <memory>
 #include "adt/List.h"
+#include "Allocations.h"
+
+/**
+ * @class ListInlineBuffer<T,N> - raw, uninitialized room for N elements of T inside an object.
+ * (Used by ListA for its inline storage; the N == 0 case takes no room.)
+ */
+template <typename T, int N>
+struct ListInlineBuffer {
+    alignas(T) unsigned char bytes[N * sizeof(T)];
+    T *get() { return reinterpret_cast<T *>(bytes); }
+    const T *get() const { return reinterpret_cast<const T *>(bytes); }
+};
+
+template <typename T>
+struct ListInlineBuffer<T, 0> {
+    T *get() { return nullptr; }
+    const T *get() const { return nullptr; }
+};
+
+/**
+ * @class ListSpan<T> - view of a contiguous run of elements (e.g., part of a ListA)
+ * that doesn't own them. Good until the list it came from reallocates or shrinks.
+ * Like a ListA, it can be used with range-for and the standard algorithms.
+ *
+ * @tparam T  element type (const T for a read-only view)
+ */
+template <typename T>
+struct ListSpan {
+    T *first;       // first element
+    int length;     // number of elements
+
+    T *begin() const { return first; }
+    T *end() const { return first + length; }
+    int size() const { return length; }
+    T& operator[](int i) const { return first[i]; }  // unchecked
+};
 
 /**
  * @class ListA<T> - template class for array implementation of List ADT.
@@ -18,17 +59,34 @@
  * remove(i): O(n)
  * insert(i): O(n)
  * append:    typically O(1), worst case is O(n), but amortized still O(1)
+ *
+ * Storage is allocated uninitialized and elements are only constructed as they
+ * are added, so T needs no 0-arg ctor. When the array grows, elements are moved
+ * (or just memcpy'd if T is trivially copyable) into the bigger one, not copied.
+ *
+ * @tparam T       data element type
+ * @tparam INLINE  number of elements to keep inside the ListA object itself; a list
+ *                 that never gets bigger than this never touches the allocator
+ * @tparam Alloc   allocator for storage beyond INLINE elements (by default, the heap,
+ *                 counted as Allocations::LIST)
  */
-template <typename T>
+template <typename T, int INLINE = 0, typename Alloc = CountingAllocator<T, Allocations::LIST>>
 class ListA : public List<T> {
 public:
     ListA();
     // "Big five":
     ~ListA();
-    ListA(const ListA<T>& other);
-    ListA& operator=(const ListA<T>& other);
-    ListA(ListA<T>&& temp);
-    ListA& operator=(ListA<T>&& temp);
+    ListA(const ListA& other);
+    ListA& operator=(const ListA& other);
+    ListA(ListA&& temp) noexcept(NOTHROW_MOVE);
+    ListA& operator=(ListA&& temp) noexcept(NOTHROW_MOVE);
+
+    /**
+     * Construct an empty list that gets its storage from the given allocator.
+     *
+     * @param alloc  allocator to use (copied)
+     */
+    explicit ListA(const Alloc &alloc);
 
     // The following methods implement the List ADT:
     int size() const;
@@ -40,13 +98,119 @@ public:
     void remove(int i);
     void clear();
     std::ostream& print(std::ostream& out) const;
+
+    /**
+     * Replace the element at index i by moving the given one in.
+     *
+     * @param i        index of element to replace
+     * @param element  element to move into the list
+     * @throws         out_of_range if i < 0 or i >= size()
+     */
+    void set(int i, T&& element);
+
+    /**
+     * Add an element to the end of the list by moving it in.
+     *
+     * @param element  element to move into the list
+     * @return         index of the new element
+     */
+    int append(T&& element);
+
+    /**
+     * Add an element to the end of the list, constructed in place from the given arguments.
+     *
+     * @tparam Args  types of ctor arguments for T
+     * @param args   ctor arguments for T
+     * @return       index of the new element
+     */
+    template <typename... Args>
+    int emplace(Args&&... args);
+
+    /**
+     * Make sure there is room for at least n elements without reallocating.
+     *
+     * @param n  number of elements to make room for
+     * @post     appends won't reallocate until size() > n
+     */
+    void reserve(int n);
+
+    /**
+     * Get the number of elements there is room for without reallocating.
+     *
+     * @return  current capacity
+     */
+    int getCapacity() const;
+
+    /**
+     * Check if the elements are still stored inside this object.
+     *
+     * @return  true if no storage has been taken from the allocator
+     */
+    bool isInline() const;
+
+    /**
+     * @return  copy of the allocator this list uses
+     */
+    Alloc getAllocator() const;
+
+    /**
+     * Random-access iterators are just pointers into the contiguous storage, so
+     * they are invalidated by anything that reallocates (append past capacity, etc.).
+     */
+    typedef T *iterator;
+    typedef const T *const_iterator;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /**
+     * Get the underlying contiguous storage: data()[0] ... data()[size()-1].
+     *
+     * @return  pointer to the first element
+     */
+    T *data();
+    const T *data() const;
+
+    /**
+     * Get the element at index i with no bounds check (unlike get), for hot loops
+     * whose bounds are already known to be good.
+     *
+     * @param i  index of element, 0 <= i < size() (not checked)
+     * @return   the element
+     */
+    T& operator[](int i);
+    const T& operator[](int i) const;
+
+    /**
+     * Get a view of count elements starting at index from.
+     *
+     * @param from   index of first element in the view
+     * @param count  number of elements in the view
+     * @return       the view
+     * @throws       out_of_range if the elements aren't all in the list
+     */
+    ListSpan<T> span(int from, int count);
+    ListSpan<const T> span(int from, int count) const;
+
 private:
+    typedef std::allocator_traits<Alloc> Traits;
     static const int DEFAULT_CAPACITY = 7;	// initial capacity for a new ListA
+    // moving can only throw when it has to move the elements one by one (into storage it may allocate)
+    static constexpr bool NOTHROW_MOVE = INLINE == 0
+            && (Traits::propagate_on_container_move_assignment::value || Traits::is_always_equal::value)
+            && std::is_nothrow_move_constructible<T>::value;
+    Alloc alloc;  // where array comes from, unless it is the inline storage
+    ListInlineBuffer<T, INLINE> local;  // array is here until we need more than INLINE elements
     int capacity; // number of elements allocated in array
     int length;  // number of elements currently being used in array
-    T *array;  // data storage of the elements
+    T *array;  // data storage of the elements (only the first length of them are constructed)
 
     void resize();
+    void reallocate(int newCapacity);
+    void release();
+    void relocate(T *from, T *to, int n);
 };
 
 /*
@@ -54,124 +218,305 @@ private:
  * (this is done in the header file because it is a template class).
  */
 
-template <typename T>
-ListA<T>::ListA() : capacity(0), length(0), array(nullptr) {
+template <typename T, int INLINE, typename Alloc>
+ListA<T, INLINE, Alloc>::ListA() : alloc(), capacity(INLINE), length(0) {
+    array = local.get();
 }
 
-template <typename T>
-ListA<T>::~ListA() {
-    delete[] array;
+template <typename T, int INLINE, typename Alloc>
+ListA<T, INLINE, Alloc>::ListA(const Alloc &alloc) : alloc(alloc), capacity(INLINE), length(0) {
+    array = local.get();
 }
 
-template <typename T>
-ListA<T>::ListA(const ListA<T>& other) : capacity(0), length(0), array(nullptr) {
+template <typename T, int INLINE, typename Alloc>
+ListA<T, INLINE, Alloc>::~ListA() {
+    clear();
+    release();
+}
+
+template <typename T, int INLINE, typename Alloc>
+ListA<T, INLINE, Alloc>::ListA(const ListA& other)
+        : alloc(Traits::select_on_container_copy_construction(other.alloc)),
+          capacity(INLINE), length(0) {
+    array = local.get();
     *this = other;  // just use the lvalue = operator
 }
 
-template <typename T>
-ListA<T>::ListA(ListA<T>&& temp) : capacity(0), length(0), array(nullptr) {
-    *this = temp;  // just use the rvalue = operator
+template <typename T, int INLINE, typename Alloc>
+ListA<T, INLINE, Alloc>::ListA(ListA&& temp) noexcept(NOTHROW_MOVE)
+        : alloc(std::move(temp.alloc)), capacity(INLINE), length(0) {
+    array = local.get();
+    *this = std::move(temp);  // just use the rvalue = operator
 }
 
-template <typename T>
-ListA<T>& ListA<T>::operator=(const ListA<T>& other) {
+template <typename T, int INLINE, typename Alloc>
+ListA<T, INLINE, Alloc>& ListA<T, INLINE, Alloc>::operator=(const ListA& other) {
     // first check if we are doing something like x = x
     if (this != &other) {
         // see if we are big enough to get a copy of all other's elements
         if (capacity < other.length) {
-            // we are not big enough, so resize to fit
-            capacity = other.capacity;
-            delete[] array;
-            array = new T[capacity];
+            // we are not big enough, so start over with enough room
+            clear();
+            release();
+            reallocate(other.capacity);
         }
-        // copy the other's elements to this
-        length = other.length;
-        for (int i = 0; i < length; i++)
+        // assign over the elements we already have, construct the rest, destroy any extras
+        int i;
+        for (i = 0; i < length && i < other.length; i++)
             array[i] = other.array[i];
+        for (; i < other.length; i++)
+            Traits::construct(alloc, array + i, other.array[i]);
+        for (; i < length; i++)
+            Traits::destroy(alloc, array + i);
+        length = other.length;
     }
     return *this;
 }
 
-template <typename T>
-ListA<T>& ListA<T>::operator=(ListA<T>&& temp) {
-    std::swap(array, temp.array);
-	std::swap(capacity, temp.capacity);
-	std::swap(length, temp.length);
+/*
+ * If temp's elements are out in allocated storage we can usually just take them.
+ * If they are in temp's inline storage (or came from an allocator we can't free to),
+ * we have to move them over one by one.
+ */
+template <typename T, int INLINE, typename Alloc>
+ListA<T, INLINE, Alloc>& ListA<T, INLINE, Alloc>::operator=(ListA&& temp) noexcept(NOTHROW_MOVE) {
+    if (this == &temp)
+        return *this;
+    clear();
+    if (!temp.isInline() && (alloc == temp.alloc || Traits::propagate_on_container_move_assignment::value)) {
+        release();
+        if (Traits::propagate_on_container_move_assignment::value)
+            alloc = std::move(temp.alloc);
+        array = temp.array;
+        capacity = temp.capacity;
+        length = temp.length;
+        temp.array = temp.local.get();
+        temp.capacity = INLINE;
+        temp.length = 0;
+    } else {
+        reserve(temp.length);
+        for (int i = 0; i < temp.length; i++)
+            Traits::construct(alloc, array + i, std::move(temp.array[i]));
+        length = temp.length;
+        temp.clear();
+    }
     return *this;
 }
 
-template <typename T>
-int ListA<T>::size() const {
+template <typename T, int INLINE, typename Alloc>
+int ListA<T, INLINE, Alloc>::size() const {
     return length;
 }
 
-template <typename T>
-void ListA<T>::set(int i, const T& element) {
+template <typename T, int INLINE, typename Alloc>
+void ListA<T, INLINE, Alloc>::set(int i, const T& element) {
     if (i < 0 || i >= length)
         throw std::out_of_range("set past bounds");
     array[i] = element;
 }
 
-template <typename T>
-const T& ListA<T>::get(int i) const {
+template <typename T, int INLINE, typename Alloc>
+void ListA<T, INLINE, Alloc>::set(int i, T&& element) {
+    if (i < 0 || i >= length)
+        throw std::out_of_range("set past bounds");
+    array[i] = std::move(element);
+}
+
+template <typename T, int INLINE, typename Alloc>
+const T& ListA<T, INLINE, Alloc>::get(int i) const {
     if (i < 0 || i >= length)
         throw std::out_of_range("get past bounds");
     return array[i];
 }
 
-template <typename T>
-int ListA<T>::append(const T& element) {
+template <typename T, int INLINE, typename Alloc>
+int ListA<T, INLINE, Alloc>::append(const T& element) {
+    return emplace(element);
+}
+
+template <typename T, int INLINE, typename Alloc>
+int ListA<T, INLINE, Alloc>::append(T&& element) {
+    return emplace(std::move(element));
+}
+
+template <typename T, int INLINE, typename Alloc>
+template <typename... Args>
+int ListA<T, INLINE, Alloc>::emplace(Args&&... args) {
     // if we don't have the capacity, then resize bigger
-    if (length == capacity)
+    if (length == capacity) {
+        // args could refer to one of our own elements, so build it before we move them
+        T element(std::forward<Args>(args)...);
         resize();
-    array[length++] = element;
-    return length-1;
+        Traits::construct(alloc, array + length, std::move(element));
+    } else {
+        Traits::construct(alloc, array + length, std::forward<Args>(args)...);
+    }
+    return length++;
 }
 
-template <typename T>
-void ListA<T>::insert(int i, const T& element) {
+template <typename T, int INLINE, typename Alloc>
+void ListA<T, INLINE, Alloc>::insert(int i, const T& element) {
     if (i > length || i < 0)
         throw std::out_of_range("insert past bounds");
+    if (i == length) {
+        append(element);
+        return;
+    }
+    T copy(element);  // element could be one of the ones we are about to shift
     // if we don't have the capacity, then resize bigger
     if (length == capacity)
         resize();
+    // open up a hole at i by shifting everything from there one to the right
+    Traits::construct(alloc, array + length, std::move(array[length-1]));
+    for (int j = length-1; j > i; j--)
+        array[j] = std::move(array[j-1]);
+    array[i] = std::move(copy);
     length++;
-    for (int j = i+1; j < length; j++)
-        array[j] = array[j-1];
-    array[i] = element;
 }
 
-template <typename T>
-void ListA<T>::resize() {
-    capacity = capacity*2 + DEFAULT_CAPACITY;
-    T *bigger = new T[capacity];
-    for (int i = 0; i < length; i++)
-        bigger[i] = array[i];
-    delete[] array;
+template <typename T, int INLINE, typename Alloc>
+void ListA<T, INLINE, Alloc>::reserve(int n) {
+    if (n > capacity)
+        reallocate(n);
+}
+
+template <typename T, int INLINE, typename Alloc>
+int ListA<T, INLINE, Alloc>::getCapacity() const {
+    return capacity;
+}
+
+template <typename T, int INLINE, typename Alloc>
+bool ListA<T, INLINE, Alloc>::isInline() const {
+    return array == local.get();
+}
+
+template <typename T, int INLINE, typename Alloc>
+Alloc ListA<T, INLINE, Alloc>::getAllocator() const {
+    return alloc;
+}
+
+template <typename T, int INLINE, typename Alloc>
+T *ListA<T, INLINE, Alloc>::begin() {
+    return array;
+}
+
+template <typename T, int INLINE, typename Alloc>
+T *ListA<T, INLINE, Alloc>::end() {
+    return array + length;
+}
+
+template <typename T, int INLINE, typename Alloc>
+const T *ListA<T, INLINE, Alloc>::begin() const {
+    return array;
+}
+
+template <typename T, int INLINE, typename Alloc>
+const T *ListA<T, INLINE, Alloc>::end() const {
+    return array + length;
+}
+
+template <typename T, int INLINE, typename Alloc>
+T *ListA<T, INLINE, Alloc>::data() {
+    return array;
+}
+
+template <typename T, int INLINE, typename Alloc>
+const T *ListA<T, INLINE, Alloc>::data() const {
+    return array;
+}
+
+template <typename T, int INLINE, typename Alloc>
+T& ListA<T, INLINE, Alloc>::operator[](int i) {
+    return array[i];
+}
+
+template <typename T, int INLINE, typename Alloc>
+const T& ListA<T, INLINE, Alloc>::operator[](int i) const {
+    return array[i];
+}
+
+template <typename T, int INLINE, typename Alloc>
+ListSpan<T> ListA<T, INLINE, Alloc>::span(int from, int count) {
+    if (from < 0 || count < 0 || from + count > length)
+        throw std::out_of_range("span past bounds");
+    return ListSpan<T>{array + from, count};
+}
+
+template <typename T, int INLINE, typename Alloc>
+ListSpan<const T> ListA<T, INLINE, Alloc>::span(int from, int count) const {
+    if (from < 0 || count < 0 || from + count > length)
+        throw std::out_of_range("span past bounds");
+    return ListSpan<const T>{array + from, count};
+}
+
+template <typename T, int INLINE, typename Alloc>
+void ListA<T, INLINE, Alloc>::resize() {
+    reallocate(capacity*2 + DEFAULT_CAPACITY);
+}
+
+template <typename T, int INLINE, typename Alloc>
+void ListA<T, INLINE, Alloc>::reallocate(int newCapacity) {
+    T *bigger = Traits::allocate(alloc, newCapacity);
+    relocate(array, bigger, length);
+    release();
     array = bigger;
+    capacity = newCapacity;
 }
 
-template <typename T>
-void ListA<T>::remove() {
+/*
+ * Give back the storage (elements must already be destroyed or relocated).
+ * Afterwards we are back to the empty inline storage.
+ */
+template <typename T, int INLINE, typename Alloc>
+void ListA<T, INLINE, Alloc>::release() {
+    if (!isInline())
+        Traits::deallocate(alloc, array, capacity);
+    array = local.get();
+    capacity = INLINE;
+}
+
+/*
+ * Move n constructed elements into uninitialized storage, leaving the source
+ * uninitialized (i.e., destroyed).
+ */
+template <typename T, int INLINE, typename Alloc>
+void ListA<T, INLINE, Alloc>::relocate(T *from, T *to, int n) {
+    if (n == 0)
+        return;
+    if (std::is_trivially_copyable<T>::value) {
+        std::memcpy(static_cast<void *>(to), static_cast<const void *>(from), n * sizeof(T));
+    } else {
+        for (int i = 0; i < n; i++) {
+            Traits::construct(alloc, to + i, std::move_if_noexcept(from[i]));
+            Traits::destroy(alloc, from + i);
+        }
+    }
+}
+
+template <typename T, int INLINE, typename Alloc>
+void ListA<T, INLINE, Alloc>::remove() {
     remove(length-1);
 }
 
-template <typename T>
-void ListA<T>::remove(int i) {
+template <typename T, int INLINE, typename Alloc>
+void ListA<T, INLINE, Alloc>::remove(int i) {
     if (i >= length || i < 0)
         throw std::out_of_range("remove past bounds");
     length--;
     for (int j = i; j < length; j++)
-        array[j] = array[j+1];
+        array[j] = std::move(array[j+1]);
+    Traits::destroy(alloc, array + length);
 }
 
-template <typename T>
-void ListA<T>::clear() {
+template <typename T, int INLINE, typename Alloc>
+void ListA<T, INLINE, Alloc>::clear() {
+    for (int i = 0; i < length; i++)
+        Traits::destroy(alloc, array + i);
     length = 0;
 }
 
-template <typename T>
-std::ostream& ListA<T>::print(std::ostream& out) const {
+template <typename T, int INLINE, typename Alloc>
+std::ostream& ListA<T, INLINE, Alloc>::print(std::ostream& out) const {
     std::string delim = "";
     for (int i = 0; i < length; i++) {
         out << delim << array[i];
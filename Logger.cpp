@@ -0,0 +1,186 @@
+/**
+ * @file Logger.cpp - implementation of Logger
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "Logger.h"
+#include "Snapshot.h"
+using namespace std;
+using chrono::steady_clock;
+
+const char Logger::MAGIC[8] = {'M', 'N', 'G', 'R', 'L', 'O', 'G', '\0'};
+
+Logger::Logger(const string &filename, int capacity)
+        : ring(capacity), out(filename, ios::binary | ios::trunc), start(steady_clock::now()), dropped(0),
+          stopping(false), napping(), wake(), writer() {
+    if (!out)
+        throw runtime_error("cannot open log " + filename);
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.recordSize = sizeof(Record);
+    header.started = time(nullptr);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    writer = thread(&Logger::write, this);
+}
+
+Logger::~Logger() {
+    {
+        lock_guard<mutex> lock(napping);
+        stopping.store(true, memory_order_release);
+    }
+    wake.notify_one();
+    writer.join();
+    out.flush();
+}
+
+void Logger::post(Level level, const char *label, int eventCount, Kind kind, Entry &entry) {
+    entry.label = label;
+    entry.record.level = level;
+    entry.record.kind = kind;
+    entry.record.label = 0;
+    entry.record.eventCount = eventCount;
+    entry.record.time = chrono::duration_cast<chrono::nanoseconds>(steady_clock::now() - start).count();
+    if (!ring.tryEnqueue(entry))
+        dropped.fetch_add(1, memory_order_relaxed);
+}
+
+void Logger::post(Level level, const char *label, int eventCount) {
+    Entry entry = {};
+    post(level, label, eventCount, MESSAGE, entry);
+}
+
+void Logger::post(Level level, const char *label, int eventCount, int value) {
+    post(level, label, eventCount, static_cast<long>(value));
+}
+
+void Logger::post(Level level, const char *label, int eventCount, long value) {
+    Entry entry = {};
+    entry.record.value = value;
+    post(level, label, eventCount, INTEGER, entry);
+}
+
+void Logger::post(Level level, const char *label, int eventCount, char value) {
+    Entry entry = {};
+    entry.record.value = value;
+    post(level, label, eventCount, CHARACTER, entry);
+}
+
+void Logger::post(Level level, const char *label, int eventCount, const Critter &value) {
+    Entry entry = {};
+    if (!value.getState(entry.record.critter))
+        entry.record.critter.kind = Snapshot::UNKNOWN;
+    post(level, label, eventCount, CRITTER, entry);
+}
+
+long Logger::getDropCount() const {
+    return dropped.load(memory_order_relaxed);
+}
+
+/*
+ * Labels are numbered in the order the writer first sees them (by address, since
+ * they're all literals), and each one's text is written just before its first use.
+ * Drops are reported as they're noticed, so they show up about where they happened.
+ * Each time the ring is found empty, the writer naps twice as long as the last time.
+ */
+void Logger::write() {
+    unordered_map<const char *, uint16_t> labels;
+    long reported = 0;
+    chrono::milliseconds nap(1);
+    for (;;) {
+        bool last = stopping.load(memory_order_acquire);  // anything posted before this is on the ring now
+        bool idle = true;
+        Entry entry;
+        while (ring.tryDequeue(entry)) {
+            idle = false;
+            auto found = labels.find(entry.label);
+            if (found == labels.end()) {
+                Record label = {};
+                label.kind = LABEL;
+                label.label = static_cast<uint16_t>(labels.size());
+                label.value = strlen(entry.label);
+                out.write(reinterpret_cast<const char *>(&label), sizeof(label));
+                out.write(entry.label, label.value);
+                found = labels.emplace(entry.label, label.label).first;
+            }
+            entry.record.label = found->second;
+            out.write(reinterpret_cast<const char *>(&entry.record), sizeof(entry.record));
+        }
+        long drops = dropped.load(memory_order_relaxed);
+        if (drops > reported) {
+            Record dropRecord = {};
+            dropRecord.level = WARN;
+            dropRecord.kind = DROPPED;
+            dropRecord.time = chrono::duration_cast<chrono::nanoseconds>(steady_clock::now() - start).count();
+            dropRecord.value = drops - reported;
+            out.write(reinterpret_cast<const char *>(&dropRecord), sizeof(dropRecord));
+            reported = drops;
+        }
+        if (last)
+            return;
+        if (idle) {
+            unique_lock<mutex> lock(napping);
+            wake.wait_for(lock, nap, [this] { return stopping.load(memory_order_acquire); });
+            nap = min(nap * 2, chrono::milliseconds(MAX_NAP));
+        } else {
+            nap = chrono::milliseconds(1);
+        }
+    }
+}
+
+void Logger::decode(const string &filename, ostream &out) {
+    ifstream in(filename, ios::binary | ios::ate);
+    if (!in)
+        throw runtime_error("cannot open log " + filename);
+    streamoff length = in.tellg();
+    in.seekg(0);
+    Header header;
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) || memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+        || header.version != VERSION || header.recordSize != sizeof(Record))
+        throw runtime_error(filename + " is not a log this program can read");
+
+    static const char *const LEVELS[] = {"DEBUG", "INFO", "WARN"};
+    vector<string> labels;
+    Record rec;
+    while (in.read(reinterpret_cast<char *>(&rec), sizeof(rec))) {
+        if (rec.kind == LABEL) {
+            if (rec.value < 0 || rec.value > length - in.tellg())
+                throw runtime_error("log " + filename + " is corrupt or cut short");
+            string text(rec.value, '\0');
+            in.read(&text[0], rec.value);
+            labels.resize(max(labels.size(), static_cast<size_t>(rec.label) + 1));
+            labels[rec.label] = text;
+            continue;
+        }
+        time_t when = header.started + rec.time / 1000000000;
+        string timestamp(ctime(&when));
+        timestamp.pop_back();  // strip trailing newline
+        out << timestamp << " +" << fixed << setprecision(6) << rec.time * 1e-9 << " "
+            << (rec.level < OFF ? LEVELS[rec.level] : "?") << " ";
+        out.unsetf(ios::floatfield);
+        if (rec.kind == DROPPED) {
+            out << "(" << rec.value << " entries dropped)" << endl;
+            continue;
+        }
+        const string &label = rec.label < labels.size() ? labels[rec.label] : "?";
+        if (rec.kind == MESSAGE) {
+            out << "(" << rec.eventCount << "):" << label << ":" << endl;
+            continue;
+        }
+        out << label << "(" << rec.eventCount << "):";
+        if (rec.kind == CHARACTER)
+            out << static_cast<char>(rec.value);
+        else if (rec.kind == CRITTER)
+            out << rec.critter;
+        else
+            out << rec.value;
+        out << ":" << endl;
+    }
+}
@@ -0,0 +1,172 @@
+/**
+ * @file Logger.h - asynchronous binary debug log
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "adt/Critter.h"
+#include "QueueMPMC.h"
+
+/**
+ * @class Logger - debug log that costs the game next to nothing to write to
+ *
+ * Posting a log entry just fills in a small binary record (no formatting, no
+ * clock-to-text, no I/O) and puts it on a lock-free ring (a QueueMPMC), so it's
+ * safe from any thread. A background thread takes them off the ring and writes
+ * them to the log file in big buffered writes; when there's nothing to write, it
+ * naps for longer and longer (up to MAX_NAP), so an idle log costs next to nothing
+ * too, and posting never has to wake it up. If the ring is ever full, the
+ * entry is dropped rather than making the game wait, and the log says how many
+ * were dropped. The file is binary; decode turns it into text.
+ *
+ * The file is a Header followed by Records, in the order they were posted. A
+ * Record's label is a number; the first time each label is used, a LABEL record
+ * with that number is written, followed by its text (value bytes of it).
+ */
+class Logger {
+public:
+    /**
+     * @enum Level - how much an entry matters
+     */
+    enum Level : std::uint8_t {
+        DEBUG,      // every frame or keystroke
+        INFO,       // every game
+        WARN,       // something went wrong
+        OFF         // (as a level to keep) nothing
+    };
+
+    /**
+     * @enum Kind - what a Record holds
+     */
+    enum Kind : std::uint8_t {
+        MESSAGE,    // just the label
+        LABEL,      // label number's text follows (value bytes of it)
+        INTEGER,    // value
+        CHARACTER,  // value is a character (a keystroke, say)
+        CRITTER,    // critter's state (its kind is UNKNOWN if it can't be snapshotted)
+        DROPPED     // value is the number of entries dropped since the last one
+    };
+
+    /**
+     * @struct Header - start of every log file
+     */
+    struct Header {
+        char magic[8];              // MAGIC
+        std::uint32_t version;      // VERSION
+        std::uint32_t recordSize;   // sizeof(Record)
+        std::int64_t started;       // time the log was started, in seconds since the epoch
+    };
+
+    /**
+     * @struct Record - one log entry
+     */
+    struct Record {
+        std::uint8_t level;         // a Level
+        std::uint8_t kind;          // a Kind
+        std::uint16_t label;        // label number
+        std::int32_t eventCount;    // how many events the game had processed
+        std::int64_t time;          // nanoseconds since the log was started
+        std::int64_t value;         // depends on kind
+        Critter::State critter;     // for a CRITTER
+    };
+
+    static const char MAGIC[8];
+    static const std::uint32_t VERSION = 1;
+
+    /**
+     * default most entries waiting to be written
+     */
+    static const int RING = 16384;
+
+    /**
+     * longest the writer sleeps between looks at the ring, in milliseconds
+     */
+    static constexpr int MAX_NAP = 64;
+
+    /**
+     * Start a new log (overwrites any existing file) and its writer thread.
+     *
+     * @param filename  where to write the log
+     * @param capacity  most entries waiting to be written before more are dropped
+     * @throws          runtime_error if the file can't be opened
+     */
+    explicit Logger(const std::string &filename, int capacity = RING);
+
+    /**
+     * Write everything still on the ring, then stop the writer thread.
+     */
+    ~Logger();
+    Logger(const Logger &other) = delete;
+    Logger& operator=(const Logger &other) = delete;
+
+    /**
+     * Post a log entry. Never waits (if the ring is full, the entry is dropped).
+     *
+     * @param level       how much it matters
+     * @param label       what it is -- must be a string literal (or otherwise outlive the Logger)
+     * @param eventCount  how many events the game has processed
+     * @param value       what to log with it, if anything
+     */
+    void post(Level level, const char *label, int eventCount);
+    void post(Level level, const char *label, int eventCount, int value);
+    void post(Level level, const char *label, int eventCount, long value);
+    void post(Level level, const char *label, int eventCount, char value);
+    void post(Level level, const char *label, int eventCount, const Critter &value);
+
+    /**
+     * @return  number of entries dropped so far because the ring was full
+     */
+    long getDropCount() const;
+
+    /**
+     * Print a log file as text, one line per entry (a file cut off between records
+     * is printed up to its last whole record).
+     *
+     * @param filename  log file
+     * @param out       where to print it
+     * @throws          runtime_error if the file can't be read, isn't a log, or has a
+     *                  label that runs past the end of it
+     */
+    static void decode(const std::string &filename, std::ostream &out);
+
+private:
+    /**
+     * @struct Entry - a Record waiting on the ring, with its label's text not yet numbered
+     */
+    struct Entry {
+        const char *label;
+        Record record;
+        friend std::ostream& operator<<(std::ostream &out, const Entry &entry) {
+            return out << entry.label << "(" << entry.record.eventCount << ")";
+        }
+    };
+
+    QueueMPMC<Entry> ring;
+    std::ofstream out;
+    std::chrono::steady_clock::time_point start;
+    std::atomic<long> dropped;
+    std::atomic<bool> stopping;
+    std::mutex napping;                 // just for waking the writer to stop (posting never locks)
+    std::condition_variable wake;
+    std::thread writer;
+
+    /**
+     * fill in an entry's record (except for the value) and put it on the ring
+     */
+    void post(Level level, const char *label, int eventCount, Kind kind, Entry &entry);
+
+    /**
+     * the writer thread: take entries off the ring and write them until stopping
+     */
+    void write();
+};
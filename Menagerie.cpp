@@ -8,7 +8,6 @@
 #include "ListA.h"
 #include "adt/Display.h"
 #include "adt/Critter.h"
-#include "QueueL.h"
 #include "Menagerie.h"
 #include "Cannon.h"
 #include "Cannonball.h"
@@ -23,27 +22,94 @@ using namespace std;
 void Menagerie::resetGame() {
   clear();
   cannonballs = 0;
+  skippedFrames = 0;
+  frameSkipRun = 0;
   int row,col;
-  display.getSize(row,col);
+  getWorldSize(row,col);
   Cannon* c = new Cannon((int)row-2,(int)col/2);
-  critters.append(c);
+  cannon = critters.insert(c);
+
+  // a scenario brings its own critters, in waves (see spawnWaves)
+  if (scenario != nullptr) {
+    preallocate();
+    return;
+  }
 
   InchWorm *worm = new InchWorm(10,10);
-  int cody = this->critters.append(worm);
-  this->events.enqueue(Event(MOVE, cody));
+  CritterMap::Handle cody = this->critters.insert(worm);
+  this->events.enqueue(Event(cody));
 
   InchWorm *worm2 = new InchWorm(15,15);
-  int cody2 = this->critters.append(worm2);
-  this->events.enqueue(Event(MOVE, cody2));
+  CritterMap::Handle cody2 = this->critters.insert(worm2);
+  this->events.enqueue(Event(cody2));
 
   Snake *snake = new Snake(20,20);
-  int cody3 = this->critters.append(snake);
-  this->events.enqueue(Event(MOVE, cody3));
+  CritterMap::Handle cody3 = this->critters.insert(snake);
+  this->events.enqueue(Event(cody3));
   
 
 }
 
 
+void Menagerie::preallocate() {
+  int population = scenario->getPopulation();
+  int peak = 1 + CANNON_BALLS + population;  // the user's Cannon and its cannonballs, too
+  critters.reserve(peak);
+  events.reserve(peak + INBOX_SIZE);  // a MOVE each, plus keystrokes
+  batch.reserve(peak);
+  batchHandles.reserve(peak);
+  spawns.reserve(population);
+  reserveRenderings(peak);
+
+  // kinds whose sizes get the same block share a free list, so each reserve counts
+  // the kinds before it on the same list, too (reserve only tops the list up)
+  CritterPool &pool = CritterPool::instance();
+  const size_t sizes[] = {sizeof(InchWorm), sizeof(Snake), sizeof(Cannonball)};
+  const int counts[] = {scenario->getPopulation(Scenario::INCHWORM), scenario->getPopulation(Scenario::SNAKE),
+                        scenario->getPopulation(Scenario::CANNONBALL) + CANNON_BALLS};
+  for (int i = 0; i < 3; i++) {
+    int count = 0;
+    for (int j = 0; j <= i; j++)
+      if (CritterPool::getBlockSize(sizes[j]) == CritterPool::getBlockSize(sizes[i]))
+        count += counts[j];
+    pool.reserve(sizes[i], count);
+  }
+}
+
+void Menagerie::spawnWaves() {
+  if (scenario == nullptr) {
+    return;
+  }
+  int row,col;
+  getWorldSize(row,col);
+  spawns.clear();
+  scenario->spawnsAt(frameCount, row, col, spawns);
+  for(const Scenario::Spawn &s : spawns) {
+    Critter *c;
+    if(s.kind == Scenario::SNAKE) {
+      c = new Snake(s.row, s.col);
+    }
+    else if(s.kind == Scenario::CANNONBALL) {
+      c = new Cannonball(s.row, s.col);
+    }
+    else {
+      c = new InchWorm(s.row, s.col);
+    }
+    // critters start out EASTbound; rotate turns EAST to SOUTH, reverse flips
+    if(s.heading == Critter::WEST || s.heading == Critter::NORTH) {
+      c->reverse();
+    }
+    if(s.heading == Critter::NORTH || s.heading == Critter::SOUTH) {
+      c->rotate();
+    }
+    CritterMap::Handle h = this->critters.insert(c);
+    this->events.enqueue(Event(h));
+    if(s.kind == Scenario::CANNONBALL) {
+      launch(h);
+    }
+  }
+}
+
 void Menagerie::processCollisions() {
   /**
    * Look for and process each collision.
@@ -51,22 +117,45 @@ void Menagerie::processCollisions() {
    * are both not transparent.
    *
    * For any collision, we kill both colliding critters with killCritter.
+   * Killing moves critters around in the slot map, so just note who collided
+   * and kill them in critter order once we're done looking (renderSwarm does
+   * the same, so both ways come out alike).
    */
   int row,cols;
   display.getSize(row,cols);
+  collided.clear();
+  for(int i = 0; i < pxms.size(); i++) {
+    collided.append(false);
+  }
 
+  // every rendering is display-sized, so walk the rows directly (no bounds checks)
   for(int i = 0; i < pxms.size()-1; i++) {
+    const PixelMatrix &pi = pxms[i];
     for(int j = i+1; j < pxms.size(); j++) {
-      for(int r = 0; r < row; r++) {
-        for(int c = 0; c < cols; c++) {
-          if(!(pxms.get(i).get(r,c).transparent) && !(pxms.get(j).get(r,c).transparent)) {
-            killCritter(i);
-            killCritter(j);
-          }
+      const PixelMatrix &pj = pxms[j];
+      bool touching = false;
+      for(int r = 0; r < row && !touching; r++) {
+        const RGB *ri = pi.getRow(r);
+        const RGB *rj = pj.getRow(r);
+        for(int c = 0; c < cols && !touching; c++) {
+          touching = !(ri[c].transparent) && !(rj[c].transparent);
         }
       }
+      if(touching) {
+        collided[i] = true;
+        collided[j] = true;
+      }
     }
   }
+  dead.clear();
+  for(int k = 0; k < collided.size(); k++) {
+    if(collided[k]) {
+      dead.append(rendered[k]);
+    }
+  }
+  for(int k = 0; k < dead.size(); k++) {
+    killCritter(dead.get(k));
+  }
 }
 
 bool Menagerie::compositeScene() {
@@ -74,12 +163,15 @@ bool Menagerie::compositeScene() {
   display.getSize(r,c);
   scene = PixelMatrix(r,c,RGB::BLACK);
   PixelMatrix old = scene;
-  for(int i = 0; i < pxms.size(); i++) {
-    scene.overlay(pxms.get(i));
+  for(const PixelMatrix &pxm : pxms) {
+    scene.overlay(pxm);
   }
   refreshDisplay();
+  return checkMovement(scene != old);
+}
 
-  if (scene != old)
+bool Menagerie::checkMovement(bool moved) {
+  if (moved)
     lastMovement = eventCount;
   else {
     log("no movement");
@@ -90,22 +182,26 @@ bool Menagerie::compositeScene() {
 
 bool Menagerie::processEvent() {
   Event e = this->events.peek();
+  Critter **user = critters.find(cannon);
   if(e.type == MOVE) {
-    for(int i = 1; i < critters.size(); i++) {
-      if(critters.get(i) !=nullptr) {
-        critters.get(i)->move();
-      }
+    Critter **c = critters.find(e.critter);
+    if(c != nullptr) {
+      (*c)->move();
+      events.enqueue(e);
     }
-    events.enqueue(Event(MOVE));
+    // else it's dead, so its moves stop here
   }
   else if(e.data == 'q') {
     return false;
   }
+  else if(user == nullptr) {
+    // cannon is dead, nothing left for the user to control
+  }
   else if(e.data == 'h') {
-    critters.get(0)->move();
+    (*user)->move();
   }
   else if(e.data == 'g') {
-    critters.get(0)->reverse();
+    (*user)->reverse();
   }
   else if(e.data == 'i') {
     shoot();
@@ -117,12 +213,13 @@ bool Menagerie::processEvent() {
 void Menagerie:: shoot() {
   int row;
   int col;
-  display.getSize(row,col);
-  col = critters.get(0)->getColumn();
+  getWorldSize(row,col);
+  col = (*critters.find(cannon))->getColumn();
   if(cannonballs < CANNON_BALLS) {
     Cannonball *c2 = new Cannonball(row-4,col);
-    int ball = this->critters.append(c2);
-    this->events.enqueue(Event(MOVE, ball));
+    CritterMap::Handle ball = this->critters.insert(c2);
+    this->events.enqueue(Event(ball));
+    launch(ball);
     cannonballs++;
   }
 }
@@ -7,10 +7,21 @@
 #pragma once
 #include <fstream>
 #include <gtest/gtest_prod.h> //import this FRIEND_TEST is here not in gtest.h
+#include "Allocations.h"
+#include "Arena.h"
+#include "Histogram.h"
 #include "ListA.h"
+#include "Logger.h"
 #include "adt/Display.h"
 #include "adt/Critter.h"
-#include "QueueL.h"
+#include "QueueA.h"
+#include "QueueMPMC.h"
+#include "Recording.h"
+#include "Scenario.h"
+#include "SlotMap.h"
+#include "Snapshot.h"
+#include "WorkerPool.h"
+#include "World.h"
 
 /**
  * @class Menagerie - the old-school shoot-the-critters terminal game
@@ -41,6 +52,189 @@ public:
      */
     void play();
 
+    /**
+     * Get the number of scenes that were not painted because the display was
+     * backlogged (see Display::isBacklogged) during the most recent game.
+     *
+     * @return  number of skipped frames
+     */
+    int getSkippedFrames() const;
+
+    /**
+     * Post a keystroke from another thread (an input, bot, or timer thread, say).
+     * It is handled just like one typed on the display, at the next frame.
+     * Safe to call from any number of threads at once, including while play() runs.
+     *
+     * @param c  the keystroke
+     * @return   false if too many posted keystrokes are already waiting (c is dropped)
+     */
+    bool postKey(int c);
+
+    /**
+     * Move and render the critters on this many threads. Each critter only touches
+     * its own state and its own rendering, and the results are merged in critter
+     * order, so games come out exactly the same for any number of threads.
+     *
+     * @param n  number of threads (1, the default, does everything on the calling thread)
+     */
+    void setThreadCount(int n);
+
+    /**
+     * Record every game played from now on.
+     *
+     * @param recorder  where to record (must outlive the games played), or nullptr to stop recording
+     */
+    void record(Recorder *recorder);
+
+    /**
+     * Replay games from a recording. From now on, each play() replays the next game
+     * from the recording, taking keystrokes from it instead of from the display.
+     * Call play() while replay->hasGame(). The display should be the same size as
+     * the one recorded on, typically a Headless one so the replay runs at full speed.
+     *
+     * Set the game up (scenario, world, swarm, sprites) the way it was recorded first.
+     *
+     * @param replay  recording to replay (must outlive the games played), or nullptr to stop replaying
+     * @throws        runtime_error if the recording was made with different settings (see getSettings)
+     */
+    void replay(Replay *replay);
+
+    /**
+     * Get the number of times the replayed games did not match the recording
+     * (initial critters, scene hashes, or game length) since replay() was called.
+     *
+     * @return  number of mismatches
+     */
+    int getReplayMismatches() const;
+
+    /**
+     * Get how the games are set up, for a Recorder to save and a Replay to check.
+     *
+     * @return  the world size, swarm size, and hashes of the scenario and the standard sprite sheet
+     */
+    Recording::Settings getSettings() const;
+
+    /**
+     * Play on from where the game is now (e.g., one just restored) instead of
+     * resetting it first, until it ends. Nothing is recorded or replayed.
+     */
+    void resume();
+
+    /**
+     * Capture the whole game (critters, events, and counters) as plain data.
+     * Taking a snapshot into one that was used before doesn't allocate.
+     *
+     * @param out  returned by reference: the snapshot
+     * @throws     logic_error if some critter can't give its state (see Critter::getState)
+     */
+    void snapshot(Snapshot &out) const;
+
+    /**
+     * Put the game back the way it was when a snapshot was taken (then resume() it).
+     *
+     * @param in  snapshot from this game or another one on a display (or in a world) of the same size
+     * @throws    invalid_argument if the snapshot is for a different size display or world
+     *            or has a critter of an unknown kind
+     */
+    void restore(const Snapshot &in);
+
+    /**
+     * Play games from a scenario instead of the standard critters: each game starts
+     * with just the user's Cannon and the scenario's waves spawn as it goes. Storage
+     * for critters, events, and renderings is sized for the scenario's whole
+     * population when the game is reset, so spawning never reallocates mid-game.
+     * (To replay a game played this way, set the same scenario first.)
+     *
+     * @param scenario  scenario to play (must outlive the games played), or nullptr for the standard game
+     */
+    void setScenario(const Scenario *scenario);
+
+    /**
+     * Swarm mode: start each game with this many more InchWorms, laid out on a grid
+     * over the whole display (which should be a big Headless one; see main's --swarm).
+     * Games with more than SWARM_CRITTERS critters are drawn without a full-screen
+     * rendering per critter (see renderSwarm), so a swarm of 100k fits in memory.
+     *
+     * @param count  number of extra worms (0, the default, for a standard game)
+     * @throws       invalid_argument if count is negative
+     */
+    void setSwarm(int count);
+
+    /**
+     * Play in a world bigger than the display: critters live anywhere in it, and the
+     * display shows a viewport onto it that follows the user's Cannon (along the bottom
+     * of the world). Every critter still moves each round, but only the ones whose
+     * bounds are in the viewport are rendered and composited (see World), and critters
+     * turn when they leave the world rather than the display. Only critters in the
+     * viewport can collide.
+     *
+     * @param rows  number of rows in the world, or 0 to play on just the display (the default)
+     * @param cols  number of columns in the world, or 0 to play on just the display
+     * @throws      invalid_argument if the world is smaller than the display
+     */
+    void setWorld(int rows, int cols);
+
+    /**
+     * End each game after this many frames, for benchmarks and the like where
+     * nobody is there to quit.
+     *
+     * @param frames  most frames per game, or 0 (the default) for no limit
+     */
+    void setFrameLimit(int frames);
+
+    /**
+     * @struct FrameStats - where the time went in the most recent game: each phase of
+     *                      a frame is timed, and how long it took each frame goes in a histogram
+     */
+    struct FrameStats {
+        /**
+         * @enum Phase - the parts of a frame that are timed
+         */
+        enum Phase {
+            EVENTS,         // processing events (moving critters, handling keystrokes, keeping up a world)
+            COLLISIONS,     // processCollisions, and finding cannonball hits after each round of events
+            TURNS,          // doTurns
+            RENDER,         // rendering critters
+            COMPOSITE,      // building the scene (in the swarm path, this includes collisions and turns)
+            DISPLAY,        // painting the display
+            KEYS,           // reading keystrokes
+            PHASES          // number of phases
+        };
+        static const char *const NAMES[PHASES];
+
+        int frames;
+        double seconds[PHASES];         // total time in each phase
+        Histogram histograms[PHASES];   // time in each phase per frame
+
+        // if Allocations is enabled, what was allocated during the frames (by subsystem)
+        Allocations::Counts allocations[Allocations::SUBSYSTEMS];
+        int allocatingFrames;           // frames that allocated anything
+        long mostAllocations;           // most allocations in one frame
+    };
+
+    /**
+     * @return  timings for the most recent game played (so far, if it is still going)
+     */
+    const FrameStats& getFrameStats() const;
+
+    /**
+     * Print where the time went in the most recent game, one phase per line: the average
+     * per frame and the median and 99th percentile (see Histogram::percentile), in ms.
+     * If Allocations is enabled, also print how many frames allocated, and what each
+     * subsystem allocated and freed during the frames.
+     *
+     * @param out  where to print
+     */
+    void printFrameStats(std::ostream &out) const;
+
+    /**
+     * Print how much memory the game is holding on to, part by part, one per line
+     * (and if Allocations is enabled, how much each subsystem has live on the heap).
+     *
+     * @param out  where to print
+     */
+    void printFootprint(std::ostream &out) const;
+
 private:
     /**
      * @enum EventType - an event on the queue can be either a MOVE, saying move a Critter
@@ -52,20 +246,27 @@ private:
     };
 
     /**
-     * @struct Event - Event is a MOVE, in which case data is the index into our lists
-     *                 for the corresponding Critter, i.e., critters.get(event.data)->move.
+     * live critters, each referred to by a handle that goes stale when it dies
+     */
+    typedef SlotMap<Critter*> CritterMap;
+
+    /**
+     * @struct Event - Event is a MOVE, in which case critter is the handle of the
+     *                 Critter to move, i.e., *critters.find(event.critter).
      *                 Or event is a COMMAND, in which case data is the key pressed.
      */
     struct Event {
         EventType type;
-        int data;       // for MOVE, this is the index of the artifact
-                        // for COMMAND, this is the keystroke character
-        Event(EventType type = MOVE, int data = 0) : type(type), data(data) {}
+        int data;                       // for COMMAND, this is the keystroke character
+        CritterMap::Handle critter;     // for MOVE, this is the critter to move
+        Event(EventType type = MOVE, int data = 0) : type(type), data(data), critter() {}
+        Event(CritterMap::Handle critter) : type(MOVE), data(0), critter(critter) {}
         friend std::ostream& operator<<(std::ostream& out, const Event& event);
     };
 
     /**
-     * number of events to process between display refreshes
+     * number of rounds of events to process between display refreshes
+     * (a round is all the events queued when it starts, so each live critter moves once)
      */
     static const int EVENT_CYCLE = 3;
 
@@ -89,11 +290,41 @@ private:
     static const int CANNON_BALLS = 7;
 
     /**
-     * If this is true, then a call to the log() method writes some text to dbug.log.
-     * Used for debugging, since it is difficult to print stuff out when the display
-     * is active.
+     * most scenes in a row we will skip painting while the display is backlogged
+     * (so a display that never catches up still shows some progress)
      */
-    static const bool LOGGING = true;
+    static const int MAX_FRAME_SKIP = 30;
+
+    /**
+     * number of critters per chunk handed to a worker thread when moving or rendering
+     */
+    static const int PARALLEL_CHUNK = 64;
+
+    /**
+     * most critters to draw with a full-screen rendering each (getRenderings and friends);
+     * past this, frames are drawn by renderSwarm
+     */
+    static const int SWARM_CRITTERS = 64;
+
+    /**
+     * Least important log() calls that write to dbug.log; the rest compile to nothing
+     * (and with Logger::OFF, the default, dbug.log isn't even opened). Used for debugging,
+     * since it is difficult to print stuff out when the display is active: build with,
+     * e.g., -DMENAGERIE_LOG_LEVEL=DEBUG to turn it on.
+     */
+#ifndef MENAGERIE_LOG_LEVEL
+#define MENAGERIE_LOG_LEVEL OFF
+#endif
+    static constexpr Logger::Level LOG_LEVEL = Logger::MENAGERIE_LOG_LEVEL;
+
+    /**
+     * @param level  how much a log entry matters
+     * @return       true if log() calls at that level write anything (a compile-time constant,
+     *               for skipping the work of getting something to log with if constexpr)
+     */
+    static constexpr bool logs(Logger::Level level) {
+        return level >= LOG_LEVEL;
+    }
 
     /**
      * How many events have been processed since start of game, resetGame()
@@ -106,30 +337,69 @@ private:
      */
     int lastMovement;
 
+    /**
+     * Number of times through the play loop since the start of the game
+     */
+    int frameCount;
+
     /**
      * Number of cannonballs left to user for this game -- CANNON_BALLS less number used
      */
     int cannonballs;
 
+    /**
+     * Number of scenes not painted this game because the display was backlogged
+     */
+    int skippedFrames;
+
+    /**
+     * Number of scenes in a row not painted (i.e., since the last actual paint)
+     */
+    int frameSkipRun;
+
     /**
      * Our display
      */
     Display& display;
 
+    /**
+     * most keystrokes posted from other threads that can wait for the next frame
+     */
+    static const int INBOX_SIZE = 64;
+
+    /**
+     * Keystrokes posted by other threads (see postKey), waiting for readKeys
+     */
+    QueueMPMC<int> inbox;
+
     /**
      * Pixel map sent to display (is the composite of all the renderings)
      */
     PixelMatrix scene;
 
     /**
-     * List of all the critters (pointers to them), nullptr if the critter is dead
+     * number of critters we make room for up front, so a standard game (cannon, worms,
+     * and all the cannonballs) doesn't allocate for critters, events, or collisions once
+     * it's going (reserved on the heap: the slot map's lists aren't inline, since a swarm
+     * grows them to many thousands and they'd make every Menagerie that much bigger)
+     */
+    static const int INLINE_CRITTERS = 16;
+
+    /**
+     * All the live critters (pointers to them). Dead ones are erased, so iterating
+     * with critters.get(i) only sees live ones.
      */
-    ListA<Critter*> critters;
+    CritterMap critters;
 
     /**
-     * Queue of unprocessed events
+     * Handle of the user's Cannon (stale once it is dead)
      */
-    QueueL<Event> events;
+    CritterMap::Handle cannon;
+
+    /**
+     * Queue of unprocessed events (a circular array, so steady-state play doesn't allocate)
+     */
+    QueueA<Event> events;
 
     /**
      * One pixel matrix for each critter (will be composited onto scene).
@@ -138,12 +408,187 @@ private:
     ListA<PixelMatrix> pxms;
 
     /**
-     * Logfile used internally by log() if LOGGING == true
+     * Threads to move and render critters on, or nullptr to do it all on the game thread
+     */
+    WorkerPool *workers;
+
+    /**
+     * Critters to move in the current batch of MOVE events (see moveBatch), and their handles
+     */
+    ListA<Critter*> batch;
+    ListA<CritterMap::Handle> batchHandles;
+
+    /**
+     * pxms.get(i) is the rendering of the critter with handle rendered.get(i)
+     * (critters killed since getRenderings leave gaps in the dense order, so doTurns goes by these)
+     */
+    ListA<CritterMap::Handle> rendered;
+
+    /**
+     * @struct Fragment - one visible pixel of a critter's rendering: where it is
+     *                    (row * number of columns + column) and what color
+     */
+    struct Fragment {
+        int cell;
+        RGB color;
+        Fragment(int cell = 0, RGB color = RGB::TRANSPARENT) : cell(cell), color(color) {}
+        friend std::ostream& operator<<(std::ostream &out, const Fragment &f) {
+            return out << f.cell << ":" << f.color;
+        }
+    };
+
+    /**
+     * @struct RenderChunk - visible pixels of the critters in one PARALLEL_CHUNK of them;
+     *                       critter k of the chunk has pixels from ends.get(k-1) (or 0) to ends.get(k)
+     */
+    struct RenderChunk {
+        ListA<Fragment> pixels;
+        ListA<int> ends;
+        friend std::ostream& operator<<(std::ostream &out, const RenderChunk &chunk) {
+            return out << chunk.ends.size() << " critters, " << chunk.pixels.size() << " pixels";
+        }
+    };
+
+    /**
+     * Swarm path state, kept from frame to frame so it doesn't reallocate:
+     * renderChunks has the critters' visible pixels (from renderSwarm),
+     * owners has the index of the first critter with a pixel in each scene cell (or -1),
+     * collided flags the critters that ran into another one this frame (processCollisions
+     * uses it, and dead, too), dead has the handles of those, to kill once they're all found,
+     * revived has the pixels of critters that turned this frame, and
+     * lost has the handles of the ones that didn't come back from their turn
+     * (the per-frame critter lists hold a standard game's worth inline)
+     */
+    ListA<RenderChunk> renderChunks;
+    ListA<int> owners;
+    ListA<bool, INLINE_CRITTERS> collided;
+    ListA<CritterMap::Handle, INLINE_CRITTERS> dead;
+    ListA<Fragment> revived;
+    ListA<CritterMap::Handle, INLINE_CRITTERS> lost;
+
+    /**
+     * @struct Projectile - a Cannonball in flight (they all fly straight north, a row a move),
+     *                     and the row its pixel was on when it was last checked for hits
+     */
+    struct Projectile {
+        CritterMap::Handle ball;
+        int row;
+        friend std::ostream& operator<<(std::ostream &out, const Projectile &p) {
+            return out << p.ball << "@" << p.row;
+        }
+    };
+
+    /**
+     * @struct Path - the cells projectiles[projectile] went through since it was last
+     *                checked: column col, rows from up to to (inclusive). Paths sort by
+     *                column, then row, so those in any one column are together, in order.
+     */
+    struct Path {
+        int col, from, to;
+        int projectile;
+        Path(int col = 0, int from = 0, int to = 0, int projectile = 0)
+                : col(col), from(from), to(to), projectile(projectile) {}
+        bool operator<(const Path &other) const {
+            return col != other.col ? col < other.col : from < other.from;
+        }
+        friend std::ostream& operator<<(std::ostream &out, const Path &path) {
+            return out << path.col << ":" << path.from << "-" << path.to;
+        }
+    };
+
+    /**
+     * @struct Hit - projectiles[projectile] hit critters.get(target)
+     */
+    struct Hit {
+        int projectile, target;
+        Hit(int projectile = 0, int target = 0) : projectile(projectile), target(target) {}
+        bool operator<(const Hit &other) const {
+            return projectile != other.projectile ? projectile < other.projectile : target < other.target;
+        }
+        friend std::ostream& operator<<(std::ostream &out, const Hit &hit) {
+            return out << hit.projectile << "->" << hit.target;
+        }
+    };
+
+    /**
+     * Projectile state, kept from round to round so it doesn't reallocate:
+     * projectiles has the cannonballs in flight (in the order they were launched),
+     * flying flags the critters that are cannonballs, sweepArena is where each round's
+     * index of ball paths and list of hits are built (it is reset every round), hits has
+     * the handles of the critters hit (ball, then target, for each hit), and sweep is
+     * the scratch matrix for the cells a ball went through
+     */
+    ListA<Projectile> projectiles;
+    ListA<bool> flying;
+    Arena sweepArena;
+    ListA<CritterMap::Handle, INLINE_CRITTERS> hits;
+    PixelMatrix sweep;
+
+    /**
+     * Scenario games are played from, or nullptr for the standard game, and the
+     * critters it spawns on the current frame (see spawnWaves)
      */
-    std::ostream *logfile;
+    const Scenario *scenario;
+    ListA<Scenario::Spawn> spawns;
+
+    /**
+     * Renderings not in use since critters died, kept for when there are more critters again
+     */
+    ListA<PixelMatrix> sparePxms;
+
+    /**
+     * The world the critters live in, or nullptr if it's just the display (see setWorld),
+     * and where the viewport the display shows is in it
+     */
+    World *world;
+    int cameraRow, cameraCol;
+
+    /**
+     * Indices of the critters to draw this frame, in increasing order
+     * (all of them, unless there's a world and some are out of the viewport)
+     */
+    ListA<int> drawn;
+
+    /**
+     * Number of extra worms for each game (see setSwarm)
+     */
+    int swarmSize;
+
+    /**
+     * Most frames per game, or 0 for no limit (see setFrameLimit)
+     */
+    int frameLimit;
+
+    /**
+     * Timings for the current (or last) game, and for the current frame so far (by phase)
+     */
+    FrameStats stats;
+    double frameTimes[FrameStats::PHASES];
+    Allocations::Counts allocationsBefore[Allocations::SUBSYSTEMS];  // as of the start of the current frame
+
+    /**
+     * Where to record games played, if anywhere
+     */
+    Recorder *recorder;
+
+    /**
+     * Recording to replay games from, if any
+     */
+    Replay *replayer;
+
+    /**
+     * Number of differences found between replayed games and their recording
+     */
+    int replayMismatches;
+
+    /**
+     * Log used internally by log(), or nullptr if LOG_LEVEL is Logger::OFF
+     */
+    Logger *logger;
 
     /**
      * empty out the data members: critters, events, etc.
+     * (and give the critters' memory back to the CritterPool all at once)
      */
     void clear();
 
@@ -153,7 +598,125 @@ private:
     void resetGame();
 
     /**
-     * render each live critter into pxms
+     * play the current game until it ends (the frame loop of play() and resume())
+     */
+    void run();
+
+    /**
+     * start timing a game from scratch (see getFrameStats)
+     */
+    void clearStats();
+
+    /**
+     * add the current frame's times (and allocations) to the stats, and start timing the next one
+     */
+    void endFrame();
+
+    /**
+     * size all the storage for critters, events, and renderings (and the CritterPool)
+     * for the scenario's whole population, plus the user's Cannon and cannonballs
+     */
+    void preallocate();
+
+    /**
+     * make room for this many renderings (in pxms and sparePxms, or for a swarm, renderChunks)
+     * @param population  most critters there will be
+     */
+    void reserveRenderings(int population);
+
+    /**
+     * Get the size of the area the critters live in: the world, if there is one, else the display.
+     *
+     * @param rows  returned by reference: number of rows
+     * @param cols  returned by reference: number of columns
+     */
+    void getWorldSize(int &rows, int &cols) const;
+
+    /**
+     * Keep up the world for this frame: turn the critters that have left it, point the
+     * camera at the user's Cannon, and find the critters in the viewport for drawn.
+     *
+     * @param update  true to also turn critters (false for a game's first scene)
+     */
+    void updateWorld(bool update);
+
+    /**
+     * spawn the scenario's critters for this frame (frameCount), and queue their MOVEs
+     */
+    void spawnWaves();
+
+    /**
+     * add the swarm of swarmSize InchWorms (and their MOVEs) to a freshly reset game
+     */
+    void spawnSwarm();
+
+    /**
+     * Start tracking a Cannonball just added to critters (see sweepProjectiles).
+     *
+     * @param ball  its handle
+     */
+    void launch(CritterMap::Handle ball);
+
+    /**
+     * Find the cannonballs that hit something in the round of events just processed,
+     * and kill them and what they hit.
+     *
+     * Hits are found from each ball's trajectory rather than from the scene: a ball
+     * only ever goes straight north along its column, so since the last check it went
+     * through the cells from where it is now down to where it was then. Any critter
+     * with a pixel in those cells (looked for with Critter::renderClipped, and only
+     * if the critter's bounds reach them) was hit. Checking every round, and the whole
+     * path, catches a ball and a critter that pass through each other between scenes,
+     * which comparing renderings never sees.
+     *
+     * The paths are sorted by column and row (see Path), so each critter finds the
+     * ones that might reach it with a binary search per column it spans, rather than
+     * checking every ball in flight.
+     */
+    void sweepProjectiles();
+
+    /**
+     * Render the critters, composite them into the scene, and refresh the display,
+     * by way of getRenderings() and compositeScene() or, for a swarm or a world, renderSwarm().
+     *
+     * @param update  true to also process collisions and turns (false for a game's first scene)
+     * @return        true if we still have movement (see compositeScene)
+     */
+    bool drawScene(bool update);
+
+    /**
+     * Draw a big game's scene without a full-screen rendering per critter.
+     *
+     * Each critter is rendered into a scratch matrix (one per thread), and just the
+     * part inside its bounds (see Critter::getBounds) is scanned for visible pixels,
+     * which are kept in renderChunks. Then, in critter order, the pixels are painted
+     * onto the scene while owners notes who is where, so a pixel landing on another
+     * critter's is a collision, and a critter with no pixels at all is turned on the spot.
+     * Collisions, turns, and kills come out exactly as they do with getRenderings(),
+     * processCollisions(), doTurns(), and compositeScene().
+     *
+     * Only the critters in drawn are rendered, and with a world, they are rendered
+     * relative to the camera, and leaving the viewport is not a turn (see updateWorld).
+     *
+     * @param update  true to also process collisions and turns
+     * @return        true if any pixel of the scene isn't black
+     */
+    bool renderSwarm(bool update);
+
+    /**
+     * Render the part of a critter that's in scratch (see Critter::renderClipped) and
+     * append its visible pixels (within its bounds, if it knows them) to out, leaving
+     * scratch all transparent again.
+     *
+     * @param c        critter to render
+     * @param scratch  display-sized, all transparent pixel matrix (with its origin
+     *                 where the viewport is; the pixels are relative to that)
+     * @param out      where to put the visible pixels
+     */
+    static void renderPixels(const Critter *c, PixelMatrix &scratch, ListA<Fragment> &out);
+
+    /**
+     * render each live critter into pxms (in parallel, if we have workers)
      * critters.get(i) is rendered into pxms.get(i)
      */
     void getRenderings();
@@ -163,7 +726,8 @@ private:
      * A collision is where pxms.get(i).get(r,c) and pxms.get(j).get(r,c)
      * are both not transparent.
      *
-     * For any collision, we kill both colliding critters with killCritter.
+     * For any collision, we kill both colliding critters with killCritter
+     * (after looking at all the pairs, since killing moves critters around).
      */
     void processCollisions();
 
@@ -174,10 +738,19 @@ private:
      * Then we rotate to get them pointing down, move, then rotate back
      * the other direction. If after this procedure and several moves (say
      * TURN_REVIVAL of them), we still have a blank rendering, then kill the
-     * critter.
+     * critter (after looking at all of them, since killing moves critters around).
      */
     void doTurns();
 
+    /**
+     * Start a critter's turn at the side of the screen: point it down, move it
+     * down a row, then point it back the other way. (It still has to move back
+     * onto the screen; that's up to the caller.)
+     *
+     * @param c  critter to turn
+     */
+    void startTurn(Critter *c);
+
     /**
      * do the compositing of all the critters
      * @return   true if we still have movement (within the last
@@ -186,10 +759,45 @@ private:
     bool compositeScene();
 
     /**
-     * Refresh the display with the current scene
+     * Note whether the scene just composited showed any movement.
+     *
+     * @param moved  true if the scene is not all black
+     * @return       true if we still have movement (within the last NO_MOVEMENT events)
+     */
+    bool checkMovement(bool moved);
+
+    /**
+     * Refresh the display with the current scene.
+     *
+     * If the display is backlogged, the scene is skipped instead (up to MAX_FRAME_SKIP
+     * in a row). Since every scene is a full composite, the next one painted covers
+     * everything the skipped ones would have shown.
      */
     void refreshDisplay();
 
+    /**
+     * Get any key presses (from the display, then any posted with postKey) and
+     * stick them on the queue as COMMAND(keystroke).
+     * When replaying, the keystrokes come from the recording for this frame instead
+     * of from the display.
+     */
+    void readKeys();
+
+    /**
+     * Start recording the game just reset, or check it against the recording being replayed.
+     */
+    void beginGame();
+
+    /**
+     * Record or check the scene just composited (only if frames are hashed in the recording).
+     */
+    void checkFrame();
+
+    /**
+     * Finish recording the game just played, or check its length against the recording.
+     */
+    void endGame();
+
     /**
      * process next event
      *
@@ -198,7 +806,7 @@ private:
      *
      * If it is a COMMAND, if data is:
      * 'q'  - quit current game (return false)
-     * 'h'  - move Cannon (the user's Cannon is at critters.get(0))
+     * 'h'  - move Cannon (the user's Cannon is *critters.find(cannon))
      * 'g'  - reverse Cannon
      * 'i'  - shoot a Cannonball (call shoot())
      *
@@ -207,37 +815,72 @@ private:
     bool processEvent();
 
     /**
-     * Make critter.get(i) dead
-     * Delete and set to nullptr to indicate it is dead.
+     * Process the run of MOVE events at the front of the queue (up to limit of them)
+     * as one batch: the critters' move() calls are spread over the workers, then the
+     * live ones' MOVEs are queued again in the same order processEvent would have.
+     * Each live critter has just one MOVE on the queue, so no critter is moved twice
+     * at once.
+     *
+     * @param limit  most events to take off the queue
+     * @return       number of events taken off the queue (0 if the front isn't a MOVE)
+     */
+    int moveBatch(int limit);
+
+    /**
+     * Run body over the indices 0...n-1 in chunks, on the workers if there are any.
+     *
+     * @param n     number of indices
+     * @param body  loop body for indices begin up to end
+     */
+    void parallelFor(int n, const WorkerPool::Body &body);
+
+    /**
+     * Make a critter dead
+     * Delete it and erase it from critters, so its handle goes stale.
+     * Does nothing if it is already dead.
      *
-     * @param i   critter index (into critters)
+     * @param h   critter handle
      */
-    void killCritter(int i);
+    void killCritter(CritterMap::Handle h);
 
     /**
-     * shoot a cannonball starting above user's Cannon (which is at critters.get(0)),
+     * shoot a cannonball starting above user's Cannon (which is *critters.find(cannon)),
      * i.e. add a Cannonball critter to critters list and queue a MOVE event for it.
      */
     void shoot();
 
     /**
-     * Write to log file, dbug.log if LOGGING is true.
+     * Write to the log file, dbug.log, if level is at least LOG_LEVEL.
      *
-     * The log file, dbug.log, is rewritten for every game. It contains a timestamp and the output
-     * from the given object (prefixed by the optional label). This is useful
-     * for debugging while the display is taken over by the game.
-     * @tparam T      datatype of object to be printed -- must support << operator
-     * @param what    object to be printed
-     * @param label   optional label to put next to timestamp
+     * The log file, dbug.log, is rewritten for every Menagerie. It contains a timestamp, the
+     * event count, and the given object (prefixed by its label). It's binary, and written on
+     * another thread (see Logger), so logging doesn't slow down the frame; read it with
+     * menagerie --read-log dbug.log. This is useful for debugging while the display is taken
+     * over by the game. Below LOG_LEVEL, the call compiles to nothing, but its arguments are
+     * still evaluated, so getting anything costly to log goes under if constexpr (logs(L)).
+     * @tparam L      how much it matters (calls below LOG_LEVEL compile to nothing)
+     * @tparam T      datatype of object to be logged -- an int, long, char, or Critter
+     * @param what    object to be logged
+     * @param label   label to put next to it (a string literal)
+     */
+    template <Logger::Level L = Logger::DEBUG, typename T>
+    void log(const T &what, const char *label) const {
+        if constexpr (logs(L)) {
+            if (logger != nullptr)
+                logger->post(L, label, eventCount, what);
+        }
+    }
+
+    /**
+     * Write a message to the log file, dbug.log, if level is at least LOG_LEVEL.
+     * @tparam L      how much it matters (calls below LOG_LEVEL compile to nothing)
+     * @param message message to log (a string literal)
      */
-    template <typename T>
-    void log(const T &what, std::string label = "") const {
-        if (logfile != nullptr) {
-            time_t rawtime;
-            time(&rawtime);
-            std::string timestamp(ctime(&rawtime));
-            timestamp.pop_back(); // strip trailing newline
-            *logfile << timestamp << " " << label << "(" << eventCount << "):" << what << ":" << std::endl;
+    template <Logger::Level L = Logger::DEBUG>
+    void log(const char *message) const {
+        if constexpr (logs(L)) {
+            if (logger != nullptr)
+                logger->post(L, message, eventCount);
         }
     }
 
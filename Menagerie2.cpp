@@ -5,59 +5,452 @@
  * @see Menagerie.cpp
  */
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
 #include "Menagerie.h"
+#include "InchWorm.h"
+#include "SpriteSheet.h"
 using namespace std;
+using chrono::steady_clock;
 
-Menagerie::Menagerie(Display &display) : eventCount(0), lastMovement(0), display(display), scene(), critters(), events(), logfile(nullptr) {
-    if (LOGGING)
-        logfile = new ofstream("dbug.log");
+/*
+ * Seconds from mark until now, and move mark up to now.
+ */
+static double lap(steady_clock::time_point &mark) {
+    steady_clock::time_point now = steady_clock::now();
+    chrono::duration<double> elapsed = now - mark;
+    mark = now;
+    return elapsed.count();
+}
+
+/*
+ * This thread's scratch matrix for renderSwarm, all transparent and rows by cols.
+ */
+static PixelMatrix& scratchMatrix(int rows, int cols) {
+    thread_local PixelMatrix scratch;
+    int srows, scols;
+    scratch.getSize(srows, scols);
+    if (srows != rows || scols != cols)
+        scratch = PixelMatrix(rows, cols, RGB::TRANSPARENT);
+    return scratch;
+}
+
+/*
+ * Approximate bytes of heap held by a pixel matrix.
+ */
+static size_t matrixBytes(const PixelMatrix &pxm) {
+    int rows, cols;
+    pxm.getSize(rows, cols);
+    return static_cast<size_t>(rows) * (cols * sizeof(RGB) + sizeof(RGB*));
+}
+
+const char *const Menagerie::FrameStats::NAMES[PHASES] = {"events", "collisions", "turns", "render", "composite",
+                                                          "display", "keys"};
+
+Menagerie::Menagerie(Display &display) : eventCount(0), lastMovement(0), frameCount(0), cannonballs(0), skippedFrames(0),
+                                         frameSkipRun(0), display(display), inbox(INBOX_SIZE), scene(), critters(), cannon(), events(),
+                                         workers(nullptr), batch(), batchHandles(), rendered(), renderChunks(), owners(), collided(), dead(),
+                                         revived(), lost(), projectiles(), flying(), sweepArena(Allocations::LIST), hits(), sweep(), scenario(nullptr), spawns(), sparePxms(), world(nullptr), cameraRow(0), cameraCol(0),
+                                         drawn(), swarmSize(0), frameLimit(0), stats(), frameTimes(), allocationsBefore(), recorder(nullptr), replayer(nullptr), replayMismatches(0), logger(nullptr) {
+    critters.reserve(INLINE_CRITTERS);
+    events.reserve(2 * INLINE_CRITTERS);  // a MOVE per critter plus room for keystrokes
+    if (LOG_LEVEL < Logger::OFF)
+        logger = new Logger("dbug.log");
 }
 
 Menagerie::~Menagerie() {
-	if (LOGGING)
-		delete logfile;
+    delete logger;
     clear();
+    delete workers;
+    delete world;
+}
+
+void Menagerie::setThreadCount(int n) {
+    delete workers;
+    workers = n > 1 ? new WorkerPool(n) : nullptr;
+}
+
+void Menagerie::parallelFor(int n, const WorkerPool::Body &body) {
+    if (workers != nullptr)
+        workers->parallelFor(n, PARALLEL_CHUNK, body);
+    else if (n > 0)
+        body(0, n);
 }
 
 void Menagerie::clear() {
-    for (int i = 0; i < critters.size(); i++)
-        killCritter(i);
+    for (Critter *c: critters)
+        delete c;
     critters.clear();
     events.clear();
+    projectiles.clear();
+    CritterPool::instance().reset();  // bulk release, unless someone else still has critters
 }
 
 void Menagerie::refreshDisplay() {
+    if (display.isBacklogged() && frameSkipRun < MAX_FRAME_SKIP) {
+        skippedFrames++;
+        frameSkipRun++;
+        return;
+    }
+    frameSkipRun = 0;
+    steady_clock::time_point mark = steady_clock::now();
     display.paint(scene);
+    frameTimes[FrameStats::DISPLAY] += lap(mark);
+}
+
+int Menagerie::getSkippedFrames() const {
+    return skippedFrames;
+}
+
+void Menagerie::setScenario(const Scenario *scenario) {
+    this->scenario = scenario;
+}
+
+void Menagerie::setSwarm(int count) {
+    if (count < 0)
+        throw invalid_argument("swarm size must not be negative");
+    swarmSize = count;
+}
+
+void Menagerie::setWorld(int rows, int cols) {
+    if ((rows != 0 || cols != 0) && (rows < display.getRowCount() || cols < display.getColCount()))
+        throw invalid_argument("world must be at least as big as the display");
+    World *made = rows == 0 && cols == 0 ? nullptr : new World(rows, cols);
+    delete world;
+    world = made;
+    cameraRow = cameraCol = 0;
+}
+
+void Menagerie::getWorldSize(int &rows, int &cols) const {
+    if (world != nullptr) {
+        rows = world->getRowCount();
+        cols = world->getColCount();
+    } else {
+        display.getSize(rows, cols);
+    }
+}
+
+void Menagerie::setFrameLimit(int frames) {
+    frameLimit = max(0, frames);
+}
+
+const Menagerie::FrameStats& Menagerie::getFrameStats() const {
+    return stats;
+}
+
+void Menagerie::printFrameStats(ostream &out) const {
+    double perFrame = 1000.0 / max(1, stats.frames);
+    out << "ms per frame  average   median      99%" << endl;
+    for (int p = 0; p < FrameStats::PHASES; p++) {
+        const Histogram &histogram = stats.histograms[p];
+        out << setw(12) << left << FrameStats::NAMES[p] << right << fixed << setprecision(3)
+            << setw(9) << stats.seconds[p] * perFrame << setw(9) << histogram.percentile(0.5) * 1000
+            << setw(9) << histogram.percentile(0.99) * 1000 << endl;
+    }
+    out.unsetf(ios::floatfield);
+    if (!Allocations::isEnabled())
+        return;
+    out << "allocations:  " << stats.allocatingFrames << " of " << stats.frames << " frames allocated, at most "
+        << stats.mostAllocations << " times" << endl;
+    for (int s = 0; s < Allocations::SUBSYSTEMS; s++) {
+        const Allocations::Counts &counts = stats.allocations[s];
+        out << "  " << setw(12) << left << Allocations::NAMES[s] << right << counts.allocations << " allocated ("
+            << counts.bytesAllocated << " bytes), " << counts.frees << " freed (" << counts.bytesFreed << " bytes)"
+            << endl;
+    }
+}
+
+void Menagerie::clearStats() {
+    stats = FrameStats();
+    for (double &t: frameTimes)
+        t = 0;
+    for (int s = 0; s < Allocations::SUBSYSTEMS; s++)
+        allocationsBefore[s] = Allocations::get(static_cast<Allocations::Subsystem>(s));
+}
+
+void Menagerie::endFrame() {
+    for (int p = 0; p < FrameStats::PHASES; p++) {
+        stats.seconds[p] += frameTimes[p];
+        stats.histograms[p].add(frameTimes[p]);
+        frameTimes[p] = 0;
+    }
+    stats.frames++;
+
+    if (!Allocations::isEnabled())
+        return;
+    long allocations = 0;
+    for (int s = 0; s < Allocations::SUBSYSTEMS; s++) {
+        Allocations::Counts now = Allocations::get(static_cast<Allocations::Subsystem>(s));
+        Allocations::Counts &before = allocationsBefore[s], &total = stats.allocations[s];
+        total.allocations += now.allocations - before.allocations;
+        total.frees += now.frees - before.frees;
+        total.bytesAllocated += now.bytesAllocated - before.bytesAllocated;
+        total.bytesFreed += now.bytesFreed - before.bytesFreed;
+        allocations += now.allocations - before.allocations;
+        before = now;
+    }
+    if (allocations > 0)
+        stats.allocatingFrames++;
+    stats.mostAllocations = max(stats.mostAllocations, allocations);
 }
 
 void Menagerie::play() {
-    bool alive = true;
     resetGame();
-    getRenderings();
-    compositeScene();
+    if (swarmSize > 0)
+        spawnSwarm();
+    frameCount = 0;
+    spawnWaves();
+    clearStats();
+    beginGame();
+    drawScene(false);
+
+    log<Logger::INFO>("play");
+    run();
+    endGame();
+    log<Logger::INFO>("game over");
+}
+
+void Menagerie::resume() {
+    Recorder *recording = recorder;
+    Replay *replaying = replayer;
+    recorder = nullptr;
+    replayer = nullptr;
+    clearStats();
+    log<Logger::INFO>("resume");
+    run();
+    recorder = recording;
+    replayer = replaying;
+    log<Logger::INFO>("game over");
+}
 
-    log("play");
+void Menagerie::run() {
+    bool alive = true;
     while (alive) {
-        // process some events
-        for (int i = 0; alive && i < EVENT_CYCLE && !events.empty(); i++)
-            alive = processEvent();
+        steady_clock::time_point mark = steady_clock::now();
+        // process some events, a round at a time (events queued during a round wait for the next)
+        for (int round = 0; alive && round < EVENT_CYCLE; round++) {
+            for (int n = events.size(); alive && n > 0; ) {
+                // a run of MOVEs goes as one batch, COMMANDs one at a time
+                int moved = moveBatch(n);
+                if (moved > 0) {
+                    n -= moved;
+                } else {
+                    alive = processEvent();
+                    n--;
+                }
+            }
+            frameTimes[FrameStats::EVENTS] += lap(mark);
+            sweepProjectiles();
+            frameTimes[FrameStats::COLLISIONS] += lap(mark);
+        }
 
         // redraw the scene
-        getRenderings();
-        processCollisions();
-        doTurns();
-        alive = compositeScene() && alive; // cannot change alive from false to true
+        alive = drawScene(true) && alive; // cannot change alive from false to true
+        checkFrame();
+
+        mark = steady_clock::now();
+        readKeys();
+        frameTimes[FrameStats::KEYS] += lap(mark);
+        frameCount++;
+        endFrame();
+        spawnWaves();
+        if (frameLimit > 0 && frameCount >= frameLimit)
+            alive = false;
+    }
+    // make sure the final scene shows up even if we were skipping
+    if (frameSkipRun > 0) {
+        frameSkipRun = 0;
+        display.paint(scene);
+    }
+    log<Logger::INFO>(skippedFrames, "skipped frames");
+}
+
+void Menagerie::snapshot(Snapshot &out) const {
+    Snapshot::Counters &counters = out.counters;
+    getWorldSize(counters.rows, counters.cols);
+    counters.cameraRow = cameraRow;
+    counters.cameraCol = cameraCol;
+    counters.eventCount = eventCount;
+    counters.lastMovement = lastMovement;
+    counters.frameCount = frameCount;
+    counters.cannonballs = cannonballs;
+    counters.skippedFrames = skippedFrames;
+    counters.frameSkipRun = frameSkipRun;
+    counters.cannon = critters.indexOf(cannon);
+
+    out.critters.clear();
+    for (Critter *c: critters) {
+        Critter::State state;
+        if (!c->getState(state))
+            throw logic_error("can't snapshot a critter that doesn't give its state");
+        out.critters.append(state);
+    }
+    out.events.clear();
+    for (int i = 0; i < events.size(); i++) {
+        const Event &event = events.get(i);
+        Snapshot::Event saved;
+        saved.type = event.type;
+        saved.data = event.data;
+        saved.critter = event.type == MOVE ? critters.indexOf(event.critter) : -1;
+        out.events.append(saved);
+    }
+}
+
+void Menagerie::restore(const Snapshot &in) {
+    const Snapshot::Counters &counters = in.counters;
+    int rows, cols;
+    getWorldSize(rows, cols);
+    if (counters.rows != rows || counters.cols != cols)
+        throw invalid_argument("snapshot is for a different size display or world");
+    clear();
+    critters.reserve(in.critters.size());
+    events.reserve(in.events.size());
+
+    // the critters go back in the same order, so snapshot indices become our new handles
+    ListA<CritterMap::Handle> handles;
+    handles.reserve(in.critters.size());
+    try {
+        for (const Critter::State &state: in.critters) {
+            handles.append(critters.insert(Snapshot::make(state)));
+            if (state.kind == Snapshot::CANNONBALL)
+                launch(handles.get(handles.size() - 1));
+        }
+        for (const Snapshot::Event &saved: in.events) {
+            Event event(static_cast<EventType>(saved.type), saved.data);
+            if (saved.type == MOVE && saved.critter >= 0)
+                event.critter = handles.get(saved.critter);
+            events.enqueue(event);
+        }
+        cannon = counters.cannon >= 0 ? handles.get(counters.cannon) : CritterMap::Handle();
+    } catch (const out_of_range &e) {
+        clear();
+        throw invalid_argument("snapshot refers to a critter it doesn't have");
+    } catch (...) {
+        clear();
+        throw;
+    }
+    eventCount = counters.eventCount;
+    lastMovement = counters.lastMovement;
+    frameCount = counters.frameCount;
+    cannonballs = counters.cannonballs;
+    skippedFrames = counters.skippedFrames;
+    frameSkipRun = counters.frameSkipRun;
+    cameraRow = counters.cameraRow;
+    cameraCol = counters.cameraCol;
+}
+
+void Menagerie::readKeys() {
+    if (replayer != nullptr) {
+        const Recording::Record *rec;
+        while ((rec = replayer->peek()) != nullptr && rec->type == Recording::COMMAND && rec->frame <= frameCount) {
+            replayer->next();
+            log(static_cast<char>(rec->value), "replayed keystroke");
+            events.enqueue(Event(COMMAND, static_cast<int>(rec->value)));
+        }
+        return;
+    }
+    int c;
+    while (display.hasKey()) {
+        c = display.getKey();
+        log(static_cast<char>(c), "keystroke");
+        events.enqueue(Event(COMMAND, c));
+        if (recorder != nullptr)
+            recorder->command(frameCount, c);
+    }
+    while (inbox.tryDequeue(c)) {
+        log(static_cast<char>(c), "posted keystroke");
+        events.enqueue(Event(COMMAND, c));
+        if (recorder != nullptr)
+            recorder->command(frameCount, c);
+    }
+}
+
+bool Menagerie::postKey(int c) {
+    return inbox.tryEnqueue(c);
+}
+
+void Menagerie::record(Recorder *recorder) {
+    this->recorder = recorder;
+}
+
+void Menagerie::replay(Replay *replay) {
+    if (replay != nullptr)
+        replay->check(getSettings());
+    replayer = replay;
+    replayMismatches = 0;
+}
+
+int Menagerie::getReplayMismatches() const {
+    return replayMismatches;
+}
+
+Recording::Settings Menagerie::getSettings() const {
+    Recording::Settings settings = {};
+    if (world != nullptr) {
+        settings.worldRows = world->getRowCount();
+        settings.worldCols = world->getColCount();
+    }
+    settings.swarm = swarmSize;
+    settings.scenario = scenario != nullptr ? scenario->hash() : 0;
+    settings.sprites = SpriteSheet::standard().hash();
+    return settings;
+}
+
+void Menagerie::beginGame() {
+    if (recorder != nullptr) {
+        recorder->game();
+        for (int i = 0; i < critters.size(); i++) {
+            Critter *c = critters.get(i);
+            recorder->critter(i, c->getHeading(), c->getColumn());
+        }
+    }
+    if (replayer != nullptr) {
+        if (!replayer->hasGame())
+            throw logic_error("no more games in replay");
+        const Recording::Record *game = replayer->next();
+        log<Logger::INFO>(game->value, "replay game");
+        const Recording::Record *rec;
+        while ((rec = replayer->peek()) != nullptr && rec->type == Recording::CRITTER) {
+            replayer->next();
+            Critter *c = rec->frame < critters.size() ? critters.get(rec->frame) : nullptr;
+            if (c == nullptr || c->getHeading() != rec->aux || c->getColumn() != rec->value) {
+                log<Logger::WARN>(rec->frame, "replay critter mismatch");
+                replayMismatches++;
+            }
+        }
+    }
+}
+
+void Menagerie::checkFrame() {
+    if (recorder != nullptr && recorder->isHashingFrames())
+        recorder->frame(frameCount, scene.hash());
+    if (replayer != nullptr) {
+        const Recording::Record *rec;
+        while ((rec = replayer->peek()) != nullptr && rec->type == Recording::FRAME && rec->frame <= frameCount) {
+            replayer->next();
+            if (rec->frame == frameCount && static_cast<uint64_t>(rec->value) != scene.hash()) {
+                log<Logger::WARN>(frameCount, "replay scene mismatch");
+                replayMismatches++;
+            }
+        }
+    }
+}
 
-        // get any key presses and stick them on the queue as COMMAND(keystroke)
-        while (display.hasKey()) {
-            int c = display.getKey();
-            log(static_cast<char>(c), "keystroke");
-            events.enqueue(Event(COMMAND, c));
+void Menagerie::endGame() {
+    if (recorder != nullptr)
+        recorder->end(frameCount);
+    if (replayer != nullptr) {
+        const Recording::Record *rec;
+        while ((rec = replayer->peek()) != nullptr && rec->type != Recording::END && rec->type != Recording::GAME)
+            replayer->next();
+        if (rec == nullptr || rec->type != Recording::END || rec->frame != frameCount) {
+            log<Logger::WARN>(frameCount, "replay length mismatch");
+            replayMismatches++;
         }
     }
-    log("game over");
 }
 
 void Menagerie::getRenderings() {
@@ -66,65 +459,505 @@ void Menagerie::getRenderings() {
     int rows = display.getRowCount();
     int cols = display.getColCount();
 
-    // get renderings from each artifact
-    pxms.clear();
-    for (int i = 0; i < n; i++) {
-        PixelMatrix pxm(rows, cols, RGB::TRANSPARENT);
-        Critter *c = critters.get(i);
-        if (c != nullptr)
-            c->render(pxm);
-        pxms.append(pxm);
+    // keep one rendering per critter from frame to frame (and spares) rather than reallocating them
+    while (pxms.size() > n) {
+        sparePxms.append(std::move(pxms[pxms.size() - 1]));
+        pxms.remove();
+    }
+    while (pxms.size() < n) {
+        if (sparePxms.size() > 0) {
+            pxms.append(std::move(sparePxms[sparePxms.size() - 1]));
+            sparePxms.remove();
+        } else {
+            pxms.append(PixelMatrix(rows, cols, RGB::TRANSPARENT));
+        }
+    }
+
+    rendered.clear();
+    for (int i = 0; i < n; i++)
+        rendered.append(critters.handleAt(i));
+
+    // get renderings from each artifact (each one only touches its own)
+    parallelFor(n, [this, rows, cols](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            PixelMatrix &pxm = pxms[i];
+            int prows, pcols;
+            pxm.getSize(prows, pcols);
+            if (prows != rows || pcols != cols)
+                pxm.resize(rows, cols);
+            pxm.paint(0, 0, rows - 1, cols - 1, RGB::TRANSPARENT);
+            critters[i]->renderClipped(pxm, 0, 0, rows - 1, cols - 1);
+        }
+    });
+}
+
+int Menagerie::moveBatch(int limit) {
+    batch.clear();
+    batchHandles.clear();
+    int taken;
+    for (taken = 0; taken < limit && !events.empty() && events.peek().type == MOVE; taken++) {
+        CritterMap::Handle h = events.peek().critter;
+        events.dequeue();
+        Critter **c = critters.find(h);
+        if (c != nullptr) {  // else it's dead, so its moves stop here
+            batch.append(*c);
+            batchHandles.append(h);
+        }
     }
+    parallelFor(batch.size(), [this](int begin, int end) {
+        for (int i = begin; i < end; i++)
+            batch[i]->move();
+    });
+    for (const CritterMap::Handle &h: batchHandles)
+        events.enqueue(Event(h));
+    return taken;
 }
 
 void Menagerie::doTurns() {
     log("turns");
-    int n = critters.size();
     int rows = display.getRowCount();
     int cols = display.getColCount();
     PixelMatrix invisible(rows, cols, RGB::TRANSPARENT);
+    lost.clear();
 
     // look for turnings
-    for (int i = 0; i < n; i++) {
-        Critter *c = critters.get(i);
-        if (c != nullptr && pxms.get(i) == invisible) {
-            bool eastbound = c->getHeading() == Critter::EAST;
-            c->rotate();
-            if (!eastbound)
-                c->reverse();
-            c->move();
-            c->move();
-            c->rotate();
-            if (!eastbound)
-                c->reverse();
+    for (int i = 0; i < pxms.size(); i++) {
+        Critter **found = critters.find(rendered[i]);
+        if (found == nullptr)
+            continue;  // killed in a collision
+        Critter *c = *found;
+        if (pxms[i] == invisible) {
+            startTurn(c);
             int j;
             for (j = 0; j < TURN_REVIVAL; j++) {
                 c->move();
                 PixelMatrix pxm = invisible;
                 c->render(pxm);
                 if (pxm != invisible) {
-                    pxms.set(i, pxm);
+                    pxms[i] = std::move(pxm);
                     break;
                 }
             }
             if (j == TURN_REVIVAL) {
-                log(*c, "lost after turn");
-                killCritter(i);
+                log<Logger::WARN>(*c, "lost after turn");
+                lost.append(rendered[i]);
+            }
+        }
+    }
+    for (int i = 0; i < lost.size(); i++)
+        killCritter(lost.get(i));
+}
+
+void Menagerie::reserveRenderings(int population) {
+    rendered.reserve(population);
+    collided.reserve(population);
+    lost.reserve(population);
+    drawn.reserve(population);
+    if (population > SWARM_CRITTERS || world != nullptr) {
+        int chunkCount = (population + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+        renderChunks.reserve(chunkCount);
+        while (renderChunks.size() < chunkCount)
+            renderChunks.append(RenderChunk());
+    } else {
+        int rows = display.getRowCount();
+        int cols = display.getColCount();
+        pxms.reserve(population);
+        sparePxms.reserve(population);
+        while (pxms.size() + sparePxms.size() < population)
+            sparePxms.append(PixelMatrix(rows, cols, RGB::TRANSPARENT));
+    }
+}
+
+void Menagerie::startTurn(Critter *c) {
+    bool eastbound = c->getHeading() == Critter::EAST;
+    c->rotate();
+    if (!eastbound)
+        c->reverse();
+    c->move();
+    c->move();
+    c->rotate();
+    if (!eastbound)
+        c->reverse();
+}
+
+void Menagerie::spawnSwarm() {
+    int rows, cols;
+    getWorldSize(rows, cols);
+
+    // a worm every 3 rows and 10 columns, eastbound and westbound rows taking turns,
+    // and the bottom rows left to the cannon
+    int gridRows = max(0, (rows - 4) / 3);
+    int gridCols = cols / 10;
+    int count = min(swarmSize, gridRows * gridCols);
+    if (count < swarmSize)
+        log<Logger::WARN>(count, "swarm doesn't fit in the world, spawning");
+    critters.reserve(critters.size() + count);
+    events.reserve(events.size() + count + INLINE_CRITTERS);
+    for (int k = 0; k < count; k++) {
+        int gridRow = k / gridCols;
+        int gridCol = k % gridCols;
+        int row = 3 * gridRow + 2;  // a bunched worm humps up a row
+        InchWorm *worm;
+        if (gridRow % 2 == 0) {
+            worm = new InchWorm(row, 10 * gridCol + 7);  // body trails up to 6 columns behind the head
+        } else {
+            worm = new InchWorm(row, 10 * gridCol + 1);
+            worm->reverse();
+        }
+        events.enqueue(Event(critters.insert(worm)));
+    }
+}
+
+void Menagerie::launch(CritterMap::Handle ball) {
+    int top, left, bottom, right;
+    (*critters.find(ball))->getBounds(top, left, bottom, right);
+    projectiles.append({ball, top});
+}
+
+void Menagerie::sweepProjectiles() {
+    if (projectiles.size() == 0)
+        return;
+    int n = critters.size();
+
+    // forget the balls that are gone, and flag the rest (they all fly the same way
+    // at the same speed, so they can't run into each other)
+    flying.clear();
+    for (int i = 0; i < n; i++)
+        flying.append(false);
+    int kept = 0;
+    for (int k = 0; k < projectiles.size(); k++) {
+        int i = critters.indexOf(projectiles[k].ball);
+        if (i >= 0) {
+            flying[i] = true;
+            projectiles[kept++] = projectiles[k];
+        }
+    }
+    while (projectiles.size() > kept)
+        projectiles.remove();
+
+    // index each ball's path since last time by column, then by row
+    sweepArena.reset();
+    ListA<Path, 0, ArenaAllocator<Path>> paths{ArenaAllocator<Path>(sweepArena)};
+    int longest = 1;
+    for (int k = 0; k < projectiles.size(); k++) {
+        Projectile &p = projectiles[k];
+        int top, left, bottom, right;
+        (*critters.find(p.ball))->getBounds(top, left, bottom, right);
+        paths.append(Path(left, top, max(top, p.row), k));
+        longest = max(longest, paths[k].to - paths[k].from + 1);
+        p.row = top;
+    }
+    sort(paths.begin(), paths.end());
+    int srows, scols;
+    sweep.getSize(srows, scols);
+    if (srows < longest)
+        sweep = PixelMatrix(longest, 1, RGB::TRANSPARENT);
+
+    // look up everything else's columns (a path starting more than longest rows above
+    // a critter's top can't reach it) and check the paths there for its pixels
+    ListA<Hit, 0, ArenaAllocator<Hit>> struck{ArenaAllocator<Hit>(sweepArena)};
+    for (int i = 0; i < n; i++) {
+        const Critter *c = critters[i];
+        int top, left, bottom, right;
+        if (flying[i] || !c->getBounds(top, left, bottom, right))
+            continue;
+        for (int col = left; col <= right; col++) {
+            const Path *path = lower_bound(paths.begin(), paths.end(), Path(col, top - longest + 1, 0, 0));
+            for (; path != paths.end() && path->col == col && path->from <= bottom; ++path) {
+                if (path->to < top)
+                    continue;
+                sweep.setOrigin(path->from, col);
+                c->renderClipped(sweep, path->from, col, path->to, col);
+                bool hit = false;
+                for (int r = 0; r <= path->to - path->from; r++)
+                    hit = hit || !sweep.get(r, 0).transparent;
+                sweep.paint(path->from, col, path->to, col, RGB::TRANSPARENT);
+                if (hit)
+                    struck.append(Hit(path->projectile, i));
+            }
+        }
+    }
+
+    // kill them ball by ball, in the order they were launched
+    sort(struck.begin(), struck.end());
+    hits.clear();
+    for (const Hit &hit: struck) {
+        if constexpr (logs(Logger::DEBUG))
+            log(*critters[hit.target], "hit by a cannonball");
+        hits.append(projectiles[hit.projectile].ball);
+        hits.append(critters.handleAt(hit.target));
+    }
+    for (int k = 0; k < hits.size(); k++)
+        killCritter(hits.get(k));
+}
+
+void Menagerie::updateWorld(bool update) {
+    int rows = display.getRowCount();
+    int cols = display.getColCount();
+    int top, left, bottom, right;
+
+    // a critter that wanders out of the world turns, just like one going off the side of the display
+    if (update) {
+        lost.clear();
+        for (int i = 0; i < critters.size(); i++) {
+            Critter *c = critters[i];
+            if (!c->getBounds(top, left, bottom, right) || world->overlaps(top, left, bottom, right))
+                continue;
+            startTurn(c);
+            bool back = false;
+            for (int j = 0; j < TURN_REVIVAL && !back; j++) {
+                c->move();
+                c->getBounds(top, left, bottom, right);
+                back = world->overlaps(top, left, bottom, right);
+            }
+            if (!back) {
+                log<Logger::WARN>(*c, "lost after turn");
+                lost.append(critters.handleAt(i));
             }
         }
+        for (int k = 0; k < lost.size(); k++)
+            killCritter(lost.get(k));
+    }
+
+    // the viewport is along the bottom of the world, following the cannon from side to side
+    Critter **user = critters.find(cannon);
+    cameraRow = world->getRowCount() - rows;
+    if (user != nullptr)
+        cameraCol = min(max((*user)->getColumn() - cols / 2, 0), world->getColCount() - cols);
+
+    // find who's in the viewport: the world narrows it down to a few chunks' worth, then check their bounds
+    world->clear();
+    drawn.clear();
+    for (int i = 0; i < critters.size(); i++) {
+        if (critters[i]->getBounds(top, left, bottom, right))
+            world->add(i, top, left, bottom, right);
+        else
+            drawn.append(i);  // can't tell where it is, so always draw it
+    }
+    int unbounded = drawn.size();
+    world->query(cameraRow, cameraCol, cameraRow + rows - 1, cameraCol + cols - 1, drawn);
+    int kept = unbounded;
+    for (int k = unbounded; k < drawn.size(); k++) {
+        critters[drawn[k]]->getBounds(top, left, bottom, right);
+        if (top < cameraRow + rows && bottom >= cameraRow && left < cameraCol + cols && right >= cameraCol)
+            drawn[kept++] = drawn[k];
+    }
+    while (drawn.size() > kept)
+        drawn.remove();
+    sort(drawn.begin(), drawn.end());
+}
+
+bool Menagerie::drawScene(bool update) {
+    if (critters.size() > SWARM_CRITTERS || world != nullptr) {
+        pxms.clear();  // a swarm doesn't use the full-screen renderings
+        if (world != nullptr) {
+            steady_clock::time_point mark = steady_clock::now();
+            updateWorld(update);
+            frameTimes[FrameStats::EVENTS] += lap(mark);  // it's game logic, not drawing
+        } else {
+            drawn.clear();
+            for (int i = 0; i < critters.size(); i++)
+                drawn.append(i);
+        }
+        bool moved = renderSwarm(update);
+        refreshDisplay();
+        return checkMovement(moved);
+    }
+    steady_clock::time_point mark = steady_clock::now();
+    getRenderings();
+    frameTimes[FrameStats::RENDER] += lap(mark);
+    if (update) {
+        processCollisions();
+        frameTimes[FrameStats::COLLISIONS] += lap(mark);
+        doTurns();
+        frameTimes[FrameStats::TURNS] += lap(mark);
     }
+    double painting = frameTimes[FrameStats::DISPLAY];
+    bool moving = compositeScene();
+    frameTimes[FrameStats::COMPOSITE] += lap(mark) - (frameTimes[FrameStats::DISPLAY] - painting);  // compositeScene refreshes the display, too
+    return moving;
 }
 
-void Menagerie::killCritter(int i) {
-    Critter *c = critters.get(i);
-    delete c;
-    critters.set(i, nullptr);
+void Menagerie::renderPixels(const Critter *c, PixelMatrix &scratch, ListA<Fragment> &out) {
+    int rows, cols, originRow, originCol;
+    scratch.getSize(rows, cols);
+    scratch.getOrigin(originRow, originCol);
+    int top = 0, left = 0, bottom = rows - 1, right = cols - 1;
+    if (c->getBounds(top, left, bottom, right)) {
+        top = max(top - originRow, 0);
+        left = max(left - originCol, 0);
+        bottom = min(bottom - originRow, rows - 1);
+        right = min(right - originCol, cols - 1);
+        if (top > bottom || left > right)
+            return;  // entirely off the screen
+    }
+    c->renderClipped(scratch, top + originRow, left + originCol, bottom + originRow, right + originCol);
+    for (int r = top; r <= bottom; r++) {
+        const RGB *row = scratch.getRow(r);
+        for (int col = left; col <= right; col++)
+            if (!row[col].transparent)
+                out.append(Fragment(r * cols + col, row[col]));
+    }
+    scratch.paint(top + originRow, left + originCol, bottom + originRow, right + originCol, RGB::TRANSPARENT);
+}
+
+bool Menagerie::renderSwarm(bool update) {
+    log("render swarm");
+    steady_clock::time_point mark = steady_clock::now();
+    int n = drawn.size();
+    int rows = display.getRowCount();
+    int cols = display.getColCount();
+    int chunkCount = (n + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+    while (renderChunks.size() < chunkCount)
+        renderChunks.append(RenderChunk());
+
+    // find each critter's visible pixels (the workers get PARALLEL_CHUNK critters at a time,
+    // too, so no two threads ever share a RenderChunk)
+    parallelFor(n, [this, rows, cols](int begin, int end) {
+        PixelMatrix &scratch = scratchMatrix(rows, cols);
+        scratch.setOrigin(cameraRow, cameraCol);
+        for (int i = begin; i < end; i++) {
+            RenderChunk &chunk = renderChunks[i / PARALLEL_CHUNK];
+            if (i % PARALLEL_CHUNK == 0) {
+                chunk.pixels.clear();
+                chunk.ends.clear();
+            }
+            renderPixels(critters[drawn[i]], scratch, chunk.pixels);
+            chunk.ends.append(chunk.pixels.size());
+        }
+    });
+    frameTimes[FrameStats::RENDER] += lap(mark);
+
+    int srows, scols;
+    scene.getSize(srows, scols);
+    if (srows != rows || scols != cols)
+        scene = PixelMatrix(rows, cols, RGB::BLACK);
+    else
+        scene.paint(0, 0, rows - 1, cols - 1, RGB::BLACK);
+    if (owners.size() != rows * cols) {
+        owners.clear();
+        owners.reserve(rows * cols);
+        for (int k = 0; k < rows * cols; k++)
+            owners.append(-1);
+    }
+    collided.clear();
+    for (int k = 0; k < critters.size(); k++)
+        collided.append(false);
+    revived.clear();
+    lost.clear();
+
+    // paint them in critter order, noting collisions and turning the critters that are out of sight
+    PixelMatrix &scratch = scratchMatrix(rows, cols);
+    scratch.setOrigin(cameraRow, cameraCol);
+    int i = 0;
+    for (int k = 0; k < chunkCount; k++) {
+        const RenderChunk &chunk = renderChunks[k];
+        int start = 0;
+        for (int end: chunk.ends) {
+            int index = drawn[i];
+            bool hit = false;
+            if (update && start == end && world == nullptr) {
+                // its pixels after the turn are painted, but can't collide until next frame
+                Critter *c = critters[index];
+                int before = revived.size();
+                startTurn(c);
+                for (int j = 0; j < TURN_REVIVAL && revived.size() == before; j++) {
+                    c->move();
+                    renderPixels(c, scratch, revived);
+                }
+                if (revived.size() == before) {
+                    log<Logger::WARN>(*c, "lost after turn");
+                    lost.append(critters.handleAt(index));
+                }
+                for (int p = before; p < revived.size(); p++)
+                    scene.paint(revived[p].cell / cols, revived[p].cell % cols, revived[p].color);
+            }
+            for (int p = start; p < end; p++) {
+                const Fragment &f = chunk.pixels[p];
+                if (update) {
+                    int &owner = owners[f.cell];
+                    if (owner < 0)
+                        owner = index;
+                    else
+                        hit = collided[owner] = true;
+                }
+                scene.paint(f.cell / cols, f.cell % cols, f.color);
+            }
+            collided[index] = hit;
+            start = end;
+            i++;
+        }
+    }
+
+    // the scene moved if any of it isn't black (and owners go back to all -1 for next time)
+    bool moved = false;
+    for (int k = 0; k < chunkCount; k++)
+        for (const Fragment &f: renderChunks[k].pixels) {
+            owners[f.cell] = -1;
+            moved = moved || scene.get(f.cell / cols, f.cell % cols) != RGB::BLACK;
+        }
+    for (const Fragment &f: revived)
+        moved = moved || scene.get(f.cell / cols, f.cell % cols) != RGB::BLACK;
+
+    // kill the collided, then the lost, in critter order (just like processCollisions and doTurns)
+    if (update) {
+        dead.clear();
+        for (int k = 0; k < collided.size(); k++)
+            if (collided[k])
+                dead.append(critters.handleAt(k));
+        for (int k = 0; k < dead.size(); k++)
+            killCritter(dead.get(k));
+        for (int k = 0; k < lost.size(); k++)
+            killCritter(lost.get(k));
+    }
+    frameTimes[FrameStats::COMPOSITE] += lap(mark);
+    return moved;
+}
+
+void Menagerie::printFootprint(ostream &out) const {
+    size_t renderings = 0;
+    for (const PixelMatrix &pxm: pxms)
+        renderings += matrixBytes(pxm);
+    for (const PixelMatrix &pxm: sparePxms)
+        renderings += matrixBytes(pxm);
+    size_t swarm = owners.getCapacity() * sizeof(int) + collided.getCapacity() * sizeof(bool)
+                   + dead.getCapacity() * sizeof(CritterMap::Handle)
+                   + revived.getCapacity() * sizeof(Fragment) + lost.getCapacity() * sizeof(CritterMap::Handle);
+    for (const RenderChunk &chunk: renderChunks)
+        swarm += chunk.pixels.getCapacity() * sizeof(Fragment) + chunk.ends.getCapacity() * sizeof(int);
+    out << "critters:     " << critters.size() << " live, " << CritterPool::instance().getBytesReserved()
+        << " bytes in the critter pool" << endl;
+    out << "critter map:  " << critters.getBytesReserved() << " bytes" << endl;
+    out << "events:       " << events.getCapacity() * sizeof(Event) << " bytes" << endl;
+    out << "renderings:   " << renderings << " bytes (" << pxms.size() << " pixel matrices, " << sparePxms.size()
+        << " spare)" << endl;
+    out << "swarm pixels: " << swarm << " bytes (" << renderChunks.size() << " chunks)" << endl;
+    out << "scene:        " << matrixBytes(scene) << " bytes" << endl;
+    if (world != nullptr)
+        out << "world:        " << world->getBytesReserved() << " bytes (" << world->getActiveChunkCount()
+            << " active chunks)" << endl;
+    if (Allocations::isEnabled()) {
+        out << "live on the heap:";
+        for (int s = 0; s < Allocations::SUBSYSTEMS; s++)
+            out << " " << Allocations::NAMES[s] << " "
+                << Allocations::get(static_cast<Allocations::Subsystem>(s)).getLiveBytes() << " bytes"
+                << (s + 1 < Allocations::SUBSYSTEMS ? "," : "");
+        out << endl;
+    }
+}
+
+void Menagerie::killCritter(CritterMap::Handle h) {
+    Critter **c = critters.find(h);
+    if (c != nullptr) {
+        delete *c;
+        critters.erase(h);
+    }
 }
 
 ostream& operator<<(std::ostream& out, const Menagerie::Event& event) {
     switch(event.type) {
         case Menagerie::MOVE:
-            out << "MOVE-" << event.data;
+            out << "MOVE-" << event.critter;
             break;
         case Menagerie::COMMAND:
             out << "COMMAND-" << static_cast<char>(event.data);
@@ -4,7 +4,9 @@
  * @see "Seattle University, CPSC 2430, Spring 2018"
  */
 
+#include <algorithm>
 #include <stdexcept>
+#include "Allocations.h"
 #include "PixelMatrix.h"
 using namespace std;
 
@@ -26,7 +28,7 @@ PixelMatrix::PixelMatrix(int nrows, int ncols, RGB **twod, int rsc, int csc) : P
 /*
  * This is the zero-arg ctor. Does no allocation. Just sets everything to zeros.
  */
-PixelMatrix::PixelMatrix() : nrows(0), ncols(0), matrix(nullptr) {
+PixelMatrix::PixelMatrix() : nrows(0), ncols(0), originRow(0), originCol(0), matrix(nullptr) {
 }
 
 /*
@@ -55,7 +57,7 @@ PixelMatrix::PixelMatrix(const PixelMatrix &other) : PixelMatrix() {
  *     PixelMap x = y + z
  */
 PixelMatrix::PixelMatrix(PixelMatrix &&temp) noexcept : PixelMatrix() {
-    *this = temp;
+    *this = std::move(temp);  // temp has a name, so without the move we'd get the copy assignment
 }
 
 /*
@@ -73,6 +75,8 @@ PixelMatrix& PixelMatrix::operator=(const PixelMatrix &other) {
         for (int r = 0; r < nrows; r++)
             for (int c = 0; c < ncols; c++)
                 matrix[r][c] = other.matrix[r][c];
+        originRow = other.originRow;
+        originCol = other.originCol;
     }
     return *this;
 }
@@ -87,6 +91,8 @@ PixelMatrix& PixelMatrix::operator=(PixelMatrix &&temp) noexcept {
     swap(matrix, temp.matrix);
     swap(nrows, temp.nrows);
     swap(ncols, temp.ncols);
+    swap(originRow, temp.originRow);
+    swap(originCol, temp.originCol);
     return *this;
 }
 
@@ -104,6 +110,7 @@ void PixelMatrix::resize(int nr, int nc, const RGB &color) {
         matrix = nullptr;
     } else {
         matrix = new RGB*[nr];
+        Allocations::allocated(Allocations::PIXEL_MATRIX, nr * (sizeof(RGB*) + nc * sizeof(RGB)), nr + 1);
         for (int r = 0; r < nr; r++) {
             matrix[r] = new RGB[nc];
             int lastoverlap = r < nrows ? min(nc,ncols) : 0;
@@ -115,6 +122,8 @@ void PixelMatrix::resize(int nr, int nc, const RGB &color) {
         }
     }
     // done with the old matrix now, so we can free it
+    if (old != nullptr)
+        Allocations::freed(Allocations::PIXEL_MATRIX, nrows * (sizeof(RGB*) + ncols * sizeof(RGB)), nrows + 1);
     for (int r = 0; r < nrows; r++)
         delete[] old[r];
     delete[] old;
@@ -136,6 +145,12 @@ const RGB& PixelMatrix::get(int row, int col) const {
     return matrix[row][col];
 }
 
+const RGB* PixelMatrix::getRow(int row) const {
+    if (row < 0 || row >= nrows)
+        throw out_of_range("no row at that coordinate");
+    return matrix[row];
+}
+
 /*
  * Just call the general paint.
  */
@@ -147,15 +162,39 @@ void PixelMatrix::paint(int row, int col, const RGB &color) {
  * Narrow the rectangle down to only valid pixels, then set them all with a nested loop.
  */
 void PixelMatrix::paint(int ulrow, int ulcol, int lrrow, int lrcol, const RGB &color) {
-    ulrow = max(0, ulrow);
-    ulcol = max(0, ulcol);
-    lrrow = min(nrows-1, lrrow);
-    lrcol = min(ncols-1, lrcol);
+    ulrow = max(0, ulrow - originRow);
+    ulcol = max(0, ulcol - originCol);
+    lrrow = min(nrows-1, lrrow - originRow);
+    lrcol = min(ncols-1, lrcol - originCol);
     for (int r = ulrow; r <= lrrow; r++)
         for (int c = ulcol; c <= lrcol; c++)
             matrix[r][c] = color;
 }
 
+/*
+ * Clip the run to the row once, then copy what's left in one go.
+ */
+void PixelMatrix::paint(int row, int col, const RGB *colors, int n) {
+    row -= originRow;
+    col -= originCol;
+    if (row < 0 || row >= nrows)
+        return;
+    int first = max(0, -col);
+    int last = min(n, ncols - col);
+    if (first < last)
+        copy(colors + first, colors + last, matrix[row] + col + first);
+}
+
+void PixelMatrix::setOrigin(int originRow, int originCol) {
+    this->originRow = originRow;
+    this->originCol = originCol;
+}
+
+void PixelMatrix::getOrigin(int &originRow, int &originCol) const {
+    originRow = this->originRow;
+    originCol = this->originCol;
+}
+
 void PixelMatrix::getSize(int &nrows, int &ncols) const {
     nrows = this->nrows;
     ncols = this->ncols;
@@ -196,6 +235,23 @@ PixelMatrix PixelMatrix::operator+(const PixelMatrix &rhs) const {
     return result;
 }
 
+uint64_t PixelMatrix::hash() const {
+    const uint64_t PRIME = 0x100000001b3;
+    uint64_t h = 0xcbf29ce484222325;
+    auto mix = [&h](unsigned value) { h = (h ^ value) * PRIME; };
+    mix(nrows);
+    mix(ncols);
+    for (int r = 0; r < nrows; r++)
+        for (int c = 0; c < ncols; c++) {
+            const RGB &px = matrix[r][c];
+            mix(px.transparent);
+            mix(px.red);
+            mix(px.green);
+            mix(px.blue);
+        }
+    return h;
+}
+
 ostream& operator<<(ostream& out, const PixelMatrix& pxm) {
     int nrows, ncols;
     pxm.getSize(nrows, ncols);
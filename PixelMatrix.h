@@ -5,6 +5,7 @@
  */
 
 #pragma once
+#include <cstdint>
 #include "RGB.h"
 
 /**
@@ -68,6 +69,26 @@ public:
      */
     void resize(int nrows, int ncols, const RGB &color = RGB::TRANSPARENT);
 
+    /**
+     * Set where this matrix is in painting coordinates: from now on, the paint methods
+     * take (row,col) to mean pixel (row - originRow, col - originCol). That way
+     * something that paints in world coordinates (a critter, say) can be rendered
+     * into a matrix covering just part of the world. (get, getRow, and the rest
+     * are unaffected; they always use the matrix's own coordinates.)
+     *
+     * @param originRow  painting row of pixel (0,0) (initially 0)
+     * @param originCol  painting column of pixel (0,0) (initially 0)
+     */
+    void setOrigin(int originRow, int originCol);
+
+    /**
+     * Get where this matrix is in painting coordinates (see setOrigin).
+     *
+     * @param originRow  returned by reference: painting row of pixel (0,0)
+     * @param originCol  returned by reference: painting column of pixel (0,0)
+     */
+    void getOrigin(int &originRow, int &originCol) const;
+
     /**
      * Get the pixel color for the given coordinates.
      *
@@ -79,6 +100,15 @@ public:
      */
     const RGB& get(int row, int col) const;
 
+    /**
+     * Get all the pixels of a row. They are contiguous, so a whole row can be copied at once.
+     *
+     * @param row  row coordinate
+     * @return     pointer to the ncols pixels of the row, get(row,0) first
+     * @throws     out_of_range if row < 0 or row >= nrows
+     */
+    const RGB* getRow(int row) const;
+
     /**
      * Set the pixel color at the given coordinates.
      * Does nothing if row or col are invalid (harmless).
@@ -105,6 +135,18 @@ public:
      */
     void paint(int ulrow, int ulcol, int lrrow, int lrcol, const RGB &color);
 
+    /**
+     * Copy a run of pixel colors into a row, starting at the given coordinates.
+     * Pixels of the run that would land outside the matrix are ignored (harmless).
+     *
+     * @param row     row coordinate
+     * @param col     column coordinate of the first color
+     * @param colors  the colors, in order of increasing column
+     * @param n       number of colors
+     * @post          get(row,col+i)==colors[i] for all valid row,col+i with 0 <= i < n
+     */
+    void paint(int row, int col, const RGB *colors, int n);
+
     /**
      * Overlay the non-transparent pixels from another pixel matrix onto this one.
      *
@@ -134,8 +176,17 @@ public:
      */
     PixelMatrix operator+(const PixelMatrix& rhs) const;
 
+    /**
+     * Hash of the dimensions and all the pixels (FNV-1a). Equal pixel matrices have
+     * equal hashes, so this is a cheap way to record or compare whole scenes.
+     *
+     * @return  64-bit hash of this pixel matrix
+     */
+    std::uint64_t hash() const;
+
 private:
     int nrows, ncols;  // dimensions of matrix
+    int originRow, originCol;  // painting coordinates of matrix[0][0]
     RGB **matrix;      // C-style 2D array of RGB structures
 };
 
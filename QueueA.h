@@ -0,0 +1,268 @@
+/**
+ * @file QueueA.h - Implementation of Queue ADT using a circular array.
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "adt/Queue.h"
+#include "Allocations.h"
+
+/**
+ * @class QueueA - Implementation of Queue ADT using a growable circular array.
+ *
+ * The elements live in one contiguous array that wraps around, so once the queue
+ * has grown to its working size (or been given it with reserve), enqueue and
+ * dequeue never allocate. All operations are O(1), except that an enqueue that
+ * has to grow the array is O(n) (amortized still O(1)).
+ *
+ * @tparam T data element type, must have a move- or copy-ctor,
+ *           and << operator to std::ostream.
+ */
+template <typename T>
+class QueueA : public Queue<T> {
+public:
+    QueueA();
+    ~QueueA();
+    QueueA(const QueueA<T>& other);
+    QueueA(QueueA<T>&& temp) noexcept;
+    QueueA<T>& operator=(const QueueA &other);
+    QueueA<T>& operator=(QueueA&& temp) noexcept;
+
+    const T& peek() const;
+    void enqueue(const T& datum);
+    void dequeue();
+    bool empty() const;
+    void clear();
+    std::ostream& print(std::ostream& out) const;
+
+    /**
+     * Add an element to the back of the queue by moving it in.
+     *
+     * @param datum  element to move into the queue
+     */
+    void enqueue(T&& datum);
+
+    /**
+     * Add an element to the back of the queue, constructed in place from the given arguments.
+     *
+     * @tparam Args  types of ctor arguments for T
+     * @param args   ctor arguments for T
+     */
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    /**
+     * Get the number of elements in the queue.
+     *
+     * @return  number of elements
+     */
+    int size() const;
+
+    /**
+     * Look at an element without removing anything.
+     *
+     * @param i  position from the front (0 is the one peek() gives)
+     * @return   the element
+     * @throws   out_of_range if i < 0 or i >= size()
+     */
+    const T& get(int i) const;
+
+    /**
+     * Make sure there is room for at least n elements without reallocating.
+     *
+     * @param n  number of elements to make room for
+     */
+    void reserve(int n);
+
+    /**
+     * Get the number of elements there is room for without reallocating.
+     *
+     * @return  current capacity
+     */
+    int getCapacity() const;
+
+private:
+    static const int DEFAULT_CAPACITY = 8;  // first capacity (always a power of two)
+    T *array;       // storage, only elements head...head+length-1 (mod capacity) are constructed
+    int capacity;   // power of two (or 0), so we can wrap with a mask
+    int head;       // index of front element
+    int length;     // number of elements
+
+    T *slot(int i) const;
+    void reallocate(int newCapacity);
+};
+
+// zero-arg constructor -- empty, with no storage yet
+template <typename T>
+QueueA<T>::QueueA() : array(nullptr), capacity(0), head(0), length(0) {
+}
+
+// destructor -- destroy the elements and free the storage
+template <typename T>
+QueueA<T>::~QueueA() {
+    clear();
+    if (array != nullptr)
+        Allocations::freed(Allocations::QUEUE, capacity * sizeof(T));
+    ::operator delete(array);
+}
+
+// copy constructor -- start empty then use the copy assignment
+template <typename T>
+QueueA<T>::QueueA(const QueueA<T>& other) : QueueA() {
+    *this = other;
+}
+
+// move constructor -- minimally construct then swap each data member
+template <typename T>
+QueueA<T>::QueueA(QueueA<T>&& temp) noexcept : QueueA() {
+    *this = std::move(temp);
+}
+
+// copy assignment operator -- copy the elements in order, front first
+template <typename T>
+QueueA<T>& QueueA<T>::operator=(const QueueA<T>& other) {
+    if (this != &other) {
+        clear();
+        reserve(other.length);
+        for (int i = 0; i < other.length; i++)
+            enqueue(*other.slot(i));
+    }
+    return *this;
+}
+
+// move assignment operator -- swap each data member
+template <typename T>
+QueueA<T>& QueueA<T>::operator=(QueueA<T>&& temp) noexcept {
+    std::swap(array, temp.array);
+    std::swap(capacity, temp.capacity);
+    std::swap(head, temp.head);
+    std::swap(length, temp.length);
+    return *this;
+}
+
+template <typename T>
+T *QueueA<T>::slot(int i) const {
+    return array + ((head + i) & (capacity - 1));
+}
+
+template <typename T>
+const T& QueueA<T>::peek() const {
+    if (length == 0)
+        throw std::logic_error("peek on empty queue");
+    return array[head];
+}
+
+template <typename T>
+void QueueA<T>::enqueue(const T &datum) {
+    emplace(datum);
+}
+
+template <typename T>
+void QueueA<T>::enqueue(T &&datum) {
+    emplace(std::move(datum));
+}
+
+template <typename T>
+template <typename... Args>
+void QueueA<T>::emplace(Args&&... args) {
+    if (length == capacity) {
+        // args could refer to one of our own elements, so build it before we move them
+        T datum(std::forward<Args>(args)...);
+        reallocate(capacity == 0 ? DEFAULT_CAPACITY : capacity * 2);
+        new (slot(length)) T(std::move(datum));
+    } else {
+        new (slot(length)) T(std::forward<Args>(args)...);
+    }
+    length++;
+}
+
+template <typename T>
+void QueueA<T>::dequeue() {
+    if (length == 0)
+        throw std::logic_error("dequeue on empty queue");
+    array[head].~T();
+    head = (head + 1) & (capacity - 1);
+    length--;
+}
+
+template <typename T>
+bool QueueA<T>::empty() const {
+    return length == 0;
+}
+
+template <typename T>
+int QueueA<T>::size() const {
+    return length;
+}
+
+template <typename T>
+void QueueA<T>::clear() {
+    for (int i = 0; i < length; i++)
+        slot(i)->~T();
+    head = 0;
+    length = 0;
+}
+
+template <typename T>
+void QueueA<T>::reserve(int n) {
+    if (n <= capacity)
+        return;
+    int newCapacity = capacity == 0 ? DEFAULT_CAPACITY : capacity;
+    while (newCapacity < n)
+        newCapacity *= 2;
+    reallocate(newCapacity);
+}
+
+template <typename T>
+const T& QueueA<T>::get(int i) const {
+    if (i < 0 || i >= length)
+        throw std::out_of_range("no such element in queue");
+    return *slot(i);
+}
+
+template <typename T>
+int QueueA<T>::getCapacity() const {
+    return capacity;
+}
+
+/*
+ * Move the elements into the new array unwrapped, i.e., with the front at index 0.
+ */
+template <typename T>
+void QueueA<T>::reallocate(int newCapacity) {
+    T *bigger = static_cast<T *>(::operator new(newCapacity * sizeof(T)));
+    Allocations::allocated(Allocations::QUEUE, newCapacity * sizeof(T));
+    if (std::is_trivially_copyable<T>::value) {
+        int first = std::min(length, capacity - head);  // elements before the wrap
+        if (first > 0)
+            std::memcpy(static_cast<void *>(bigger), static_cast<const void *>(array + head), first * sizeof(T));
+        if (length > first)
+            std::memcpy(static_cast<void *>(bigger + first), static_cast<const void *>(array), (length - first) * sizeof(T));
+    } else {
+        for (int i = 0; i < length; i++) {
+            T *from = slot(i);
+            new (bigger + i) T(std::move_if_noexcept(*from));
+            from->~T();
+        }
+    }
+    if (array != nullptr)
+        Allocations::freed(Allocations::QUEUE, capacity * sizeof(T));
+    ::operator delete(array);
+    array = bigger;
+    capacity = newCapacity;
+    head = 0;
+}
+
+template <typename T>
+std::ostream& QueueA<T>::print(std::ostream &out) const {
+    for (int i = 0; i < length; i++)
+        out << *slot(i) << " ";
+    return out;
+}
@@ -29,6 +29,22 @@ public:
     bool empty() const;
     void clear();
     std::ostream& print(std::ostream& out) const;
+
+    /**
+     * Iteration from front to back (read-only, since a queue's elements are only
+     * changed by enqueue and dequeue). Enqueue and dequeue don't invalidate
+     * iterators to other elements.
+     */
+    typedef typename std::list<T>::const_iterator const_iterator;
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /**
+     * Get the number of elements in the queue.
+     *
+     * @return  number of elements
+     */
+    int size() const;
 private:
     std::list<T> qlist;
 };
@@ -65,6 +81,7 @@ QueueL<T>::QueueL(QueueL<T>&& temp) : qlist() {
 template <typename T>
 QueueL<T>& QueueL<T>::operator=(QueueL<T>&& temp) {
     std::swap(qlist, temp.qlist);
+    return *this;
 }
 
 template <typename T>
@@ -92,6 +109,21 @@ void QueueL<T>::clear() {
     return qlist.clear();
 }
 
+template <typename T>
+typename QueueL<T>::const_iterator QueueL<T>::begin() const {
+    return qlist.begin();
+}
+
+template <typename T>
+typename QueueL<T>::const_iterator QueueL<T>::end() const {
+    return qlist.end();
+}
+
+template <typename T>
+int QueueL<T>::size() const {
+    return static_cast<int>(qlist.size());
+}
+
 template <typename T>
 std::ostream& QueueL<T>::print(std::ostream &out) const {
     for (const auto element: qlist)
@@ -0,0 +1,253 @@
+/**
+ * @file QueueMPMC.h - Implementation of Queue ADT that is safe to share between threads.
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "adt/Queue.h"
+
+/**
+ * @class QueueMPMC - bounded, lock-free, multi-producer/multi-consumer queue.
+ *
+ * Any number of threads can enqueue and dequeue at the same time without locks.
+ * This is Dmitry Vyukov's bounded MPMC queue: a power-of-two ring of cells, each
+ * with a sequence number that says whose turn it is to use the cell. A producer
+ * claims a cell by bumping the enqueue position with a compare-and-swap, fills it,
+ * and then publishes it by advancing the cell's sequence; a consumer does the same
+ * on the dequeue side. Producers and consumers only contend with their own kind,
+ * and then only for the one position counter (kept on its own cache line).
+ *
+ * The capacity is fixed when constructed. tryEnqueue and tryDequeue are the
+ * thread-safe way in and out: they return false instead of waiting when the queue
+ * is full or empty. The Queue ADT methods are here too, with some restrictions:
+ *
+ * enqueue:  safe from any thread; throws overflow_error if the queue is full
+ * dequeue:  safe from any thread; throws logic_error if the queue is empty
+ * peek:     only with a single consumer (another consumer could dequeue the front
+ *           element out from under the reference)
+ * empty:    safe, but the answer can be stale by the time the caller looks at it
+ * clear:    safe (it just dequeues until empty)
+ * print:    only while no other thread is using the queue
+ *
+ * @tparam T data element type, must have a move- or copy-ctor,
+ *           and << operator to std::ostream.
+ */
+template <typename T>
+class QueueMPMC : public Queue<T> {
+public:
+    /**
+     * @param capacity  most elements the queue can hold (rounded up to a power of two, at least 2)
+     */
+    explicit QueueMPMC(int capacity = 1024);
+
+    ~QueueMPMC();
+    QueueMPMC(const QueueMPMC<T>& other) = delete;
+    QueueMPMC(QueueMPMC<T>&& temp) = delete;
+    QueueMPMC<T>& operator=(const QueueMPMC &other) = delete;
+    QueueMPMC<T>& operator=(QueueMPMC&& temp) = delete;
+
+    const T& peek() const;
+    void enqueue(const T& datum);
+    void dequeue();
+    bool empty() const;
+    void clear();
+    std::ostream& print(std::ostream& out) const;
+
+    /**
+     * Add an element to the back of the queue if there is room.
+     *
+     * @param datum  element to copy (or move) into the queue
+     * @return       false if the queue was full (and nothing was added)
+     */
+    bool tryEnqueue(const T& datum);
+    bool tryEnqueue(T&& datum);
+
+    /**
+     * Remove the front element of the queue, if there is one.
+     *
+     * @param datum  where to move the front element to
+     * @return       false if the queue was empty (and datum is untouched)
+     */
+    bool tryDequeue(T& datum);
+
+    /**
+     * @return  most elements the queue can hold
+     */
+    int getCapacity() const;
+
+private:
+    static const std::size_t CACHE_LINE = 64;
+
+    /**
+     * @struct Cell - one place in the ring
+     * sequence == pos:             empty, the producer that claims pos can fill it
+     * sequence == pos + 1:         full, the consumer that claims pos can empty it
+     * sequence == pos + capacity:  emptied, ready for the producer of the next lap
+     */
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+        T *element() { return reinterpret_cast<T *>(storage); }
+        const T *element() const { return reinterpret_cast<const T *>(storage); }
+    };
+
+    Cell *cells;
+    std::size_t mask;   // capacity - 1
+    alignas(CACHE_LINE) std::atomic<std::size_t> enqueuePos;
+    alignas(CACHE_LINE) std::atomic<std::size_t> dequeuePos;
+    char padding[CACHE_LINE - sizeof(std::atomic<std::size_t>)];  // keep the next object off our line
+
+    Cell *claimForEnqueue(std::size_t &pos);
+    bool pop(T *datum);
+};
+
+template <typename T>
+QueueMPMC<T>::QueueMPMC(int capacity) : cells(nullptr), mask(0), enqueuePos(0), dequeuePos(0), padding() {
+    std::size_t n = 2;
+    while (n < static_cast<std::size_t>(capacity))
+        n *= 2;
+    cells = new Cell[n];
+    mask = n - 1;
+    for (std::size_t i = 0; i < n; i++)
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+// destructor -- destroy whatever is still in the queue, then free the ring
+template <typename T>
+QueueMPMC<T>::~QueueMPMC() {
+    clear();
+    delete[] cells;
+}
+
+/*
+ * Claim the cell at the enqueue position, or return nullptr if the queue is full.
+ * The difference between the cell's sequence and the position tells us if the cell
+ * is ready for us (0), still full from the last lap (< 0), or if another producer
+ * beat us to it (> 0, so try again at the new position).
+ */
+template <typename T>
+typename QueueMPMC<T>::Cell *QueueMPMC<T>::claimForEnqueue(std::size_t &pos) {
+    pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell *cell = &cells[pos & mask];
+        std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+        std::intptr_t dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+        if (dif == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return cell;
+        } else if (dif < 0) {
+            return nullptr;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+bool QueueMPMC<T>::tryEnqueue(const T &datum) {
+    std::size_t pos;
+    Cell *cell = claimForEnqueue(pos);
+    if (cell == nullptr)
+        return false;
+    new (cell->storage) T(datum);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool QueueMPMC<T>::tryEnqueue(T &&datum) {
+    std::size_t pos;
+    Cell *cell = claimForEnqueue(pos);
+    if (cell == nullptr)
+        return false;
+    new (cell->storage) T(std::move(datum));
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/*
+ * Mirror image of claimForEnqueue: the cell at the dequeue position is ours when its
+ * sequence says it's full (pos + 1). Then move the element out (if datum isn't nullptr),
+ * destroy it, and hand the cell on to the producer one lap ahead.
+ */
+template <typename T>
+bool QueueMPMC<T>::pop(T *datum) {
+    std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+        cell = &cells[pos & mask];
+        std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+        std::intptr_t dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+        if (dif == 0) {
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (dif < 0) {
+            return false;
+        } else {
+            pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+    if (datum != nullptr)
+        *datum = std::move(*cell->element());
+    cell->element()->~T();
+    cell->sequence.store(pos + mask + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool QueueMPMC<T>::tryDequeue(T &datum) {
+    return pop(&datum);
+}
+
+template <typename T>
+void QueueMPMC<T>::enqueue(const T &datum) {
+    if (!tryEnqueue(datum))
+        throw std::overflow_error("enqueue on full queue");
+}
+
+template <typename T>
+void QueueMPMC<T>::dequeue() {
+    if (!pop(nullptr))
+        throw std::logic_error("dequeue on empty queue");
+}
+
+template <typename T>
+const T& QueueMPMC<T>::peek() const {
+    std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    const Cell *cell = &cells[pos & mask];
+    if (cell->sequence.load(std::memory_order_acquire) != pos + 1)
+        throw std::logic_error("peek on empty queue");
+    return *cell->element();
+}
+
+template <typename T>
+bool QueueMPMC<T>::empty() const {
+    std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    return cells[pos & mask].sequence.load(std::memory_order_acquire) != pos + 1;
+}
+
+template <typename T>
+void QueueMPMC<T>::clear() {
+    while (pop(nullptr))
+        ;
+}
+
+template <typename T>
+int QueueMPMC<T>::getCapacity() const {
+    return static_cast<int>(mask + 1);
+}
+
+template <typename T>
+std::ostream& QueueMPMC<T>::print(std::ostream &out) const {
+    std::size_t end = enqueuePos.load(std::memory_order_acquire);
+    for (std::size_t pos = dequeuePos.load(std::memory_order_acquire); pos != end; pos++)
+        out << *cells[pos & mask].element() << " ";
+    return out;
+}
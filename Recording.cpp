@@ -0,0 +1,139 @@
+/**
+ * @file Recording.cpp - implementation of Recorder and Replay
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Recording.h"
+using namespace std;
+
+const char Recording::MAGIC[8] = {'M', 'N', 'G', 'R', 'R', 'E', 'C', '\0'};
+
+Recorder::Recorder(const string &filename, int rows, int cols, const Recording::Settings &settings, bool hashFrames)
+        : out(filename, ios::binary | ios::trunc), hashFrames(hashFrames), games(0),
+          start(chrono::steady_clock::now()) {
+    if (!out)
+        throw runtime_error("cannot open recording " + filename);
+    Recording::Header header;
+    memcpy(header.magic, Recording::MAGIC, sizeof(header.magic));
+    header.version = Recording::VERSION;
+    header.recordSize = sizeof(Recording::Record);
+    header.rows = rows;
+    header.cols = cols;
+    header.settings = settings;
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+Recorder::~Recorder() {
+    out.flush();
+}
+
+void Recorder::write(Recording::Type type, int aux, int frame, int64_t value) {
+    Recording::Record rec;
+    rec.type = type;
+    rec.aux = static_cast<uint16_t>(aux);
+    rec.frame = frame;
+    rec.time = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    rec.value = value;
+    out.write(reinterpret_cast<const char *>(&rec), sizeof(rec));
+}
+
+void Recorder::game() {
+    write(Recording::GAME, 0, 0, games++);
+}
+
+void Recorder::critter(int index, int heading, int column) {
+    write(Recording::CRITTER, heading, index, column);
+}
+
+void Recorder::command(int frame, int key) {
+    write(Recording::COMMAND, 0, frame, key);
+}
+
+void Recorder::frame(int frame, uint64_t hash) {
+    if (hashFrames)
+        write(Recording::FRAME, 0, frame, static_cast<int64_t>(hash));
+}
+
+void Recorder::end(int frame) {
+    write(Recording::END, 0, frame, 0);
+    out.flush();
+}
+
+bool Recorder::isHashingFrames() const {
+    return hashFrames;
+}
+
+Replay::Replay(const string &filename) : map(MAP_FAILED), length(0), header(nullptr), records(nullptr),
+                                         count(0), cursor(0) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw runtime_error("cannot open recording " + filename);
+    struct stat st;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(Recording::Header)) {
+        length = st.st_size;
+        map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);  // the mapping stays good after close
+    if (map == MAP_FAILED)
+        throw runtime_error("cannot map recording " + filename);
+    madvise(map, length, MADV_SEQUENTIAL);
+
+    header = static_cast<const Recording::Header *>(map);
+    if (memcmp(header->magic, Recording::MAGIC, sizeof(header->magic)) != 0
+            || header->version != Recording::VERSION
+            || header->recordSize != sizeof(Recording::Record)) {
+        munmap(map, length);
+        throw runtime_error(filename + " is not a Menagerie recording");
+    }
+    records = reinterpret_cast<const Recording::Record *>(header + 1);
+    count = (length - sizeof(Recording::Header)) / sizeof(Recording::Record);
+}
+
+Replay::~Replay() {
+    munmap(map, length);
+}
+
+int Replay::getRowCount() const {
+    return header->rows;
+}
+
+int Replay::getColCount() const {
+    return header->cols;
+}
+
+void Replay::check(const Recording::Settings &settings) const {
+    const Recording::Settings &recorded = header->settings;
+    auto world = [](const Recording::Settings &s) {
+        return s.worldRows == 0 ? string("no world") : "a world of " + to_string(s.worldRows) + "x" + to_string(s.worldCols);
+    };
+    if (settings.worldRows != recorded.worldRows || settings.worldCols != recorded.worldCols)
+        throw runtime_error("recording was made with " + world(recorded) + ", not " + world(settings));
+    if (settings.swarm != recorded.swarm)
+        throw runtime_error("recording was made with a swarm of " + to_string(recorded.swarm) + ", not "
+                            + to_string(settings.swarm));
+    if (settings.scenario != recorded.scenario)
+        throw runtime_error("recording was made with a different scenario");
+    if (settings.sprites != recorded.sprites)
+        throw runtime_error("recording was made with different sprites");
+}
+
+bool Replay::hasGame() {
+    while (cursor < count && records[cursor].type != Recording::GAME)
+        cursor++;
+    return cursor < count;
+}
+
+const Recording::Record* Replay::peek() const {
+    return cursor < count ? &records[cursor] : nullptr;
+}
+
+const Recording::Record* Replay::next() {
+    return cursor < count ? &records[cursor++] : nullptr;
+}
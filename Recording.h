@@ -0,0 +1,215 @@
+/**
+ * @file Recording.h - binary recording and replay of Menagerie sessions
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <cstdint>
+#include <chrono>
+#include <fstream>
+#include <string>
+
+/**
+ * @class Recording - file format shared by Recorder and Replay
+ *
+ * A recording is a Header followed by any number of fixed-size Records, in the
+ * order they happened. There is no index or trailer, so a recording can be
+ * written as the session goes (and a truncated one is still readable up to its
+ * last whole record), and read in place from a memory map.
+ *
+ * A session is one or more games. Each game is:
+ *     GAME, CRITTER..., then COMMAND and FRAME records by frame number, END
+ */
+class Recording {
+public:
+    /**
+     * @enum Type - what a Record holds
+     */
+    enum Type : std::uint16_t {
+        GAME,       // start of a game: value is the game number (from 0)
+        CRITTER,    // initial critter: frame is its index, aux its heading, value its column
+        COMMAND,    // keystroke: frame when it was read, value is the key
+        FRAME,      // scene painted: frame number, value is PixelMatrix::hash of the scene
+        END         // end of a game: frame is the last frame number
+    };
+
+    /**
+     * @struct Settings - how the session's games were set up (a replay has to match them)
+     */
+    struct Settings {
+        std::int32_t worldRows, worldCols;  // world size, or 0 if just the display
+        std::int32_t swarm;                 // swarm size, or 0 if not a swarm
+        std::int32_t unused;
+        std::uint64_t scenario;             // Scenario::hash, or 0 for the standard game
+        std::uint64_t sprites;              // SpriteSheet::hash of the standard sprite sheet
+    };
+
+    /**
+     * @struct Header - start of every recording file
+     */
+    struct Header {
+        char magic[8];              // MAGIC
+        std::uint32_t version;      // VERSION
+        std::uint32_t recordSize;   // sizeof(Record)
+        std::int32_t rows, cols;    // display size the session was played on
+        Settings settings;
+    };
+
+    /**
+     * @struct Record - one thing that happened
+     */
+    struct Record {
+        std::uint16_t type;     // a Type
+        std::uint16_t aux;      // extra small datum, depends on type
+        std::int32_t frame;     // frame number within the game
+        std::int64_t time;      // nanoseconds since start of recording
+        std::int64_t value;     // depends on type
+    };
+
+    static const char MAGIC[8];
+    static const std::uint32_t VERSION = 3;    // 2: each MOVE event moves just its own critter, 3: settings
+};
+
+/**
+ * @class Recorder - write a Recording of a session to a file as it is played
+ */
+class Recorder {
+public:
+    /**
+     * Start a new recording (overwrites any existing file).
+     *
+     * @param filename    where to write the recording
+     * @param rows        display rows the session is played on
+     * @param cols        display columns the session is played on
+     * @param settings    how the games are set up (see Menagerie::getSettings)
+     * @param hashFrames  if true, record a FRAME with a hash of every scene
+     * @throws            runtime_error if the file can't be opened
+     */
+    Recorder(const std::string &filename, int rows, int cols, const Recording::Settings &settings,
+             bool hashFrames = false);
+
+    ~Recorder();
+    Recorder(const Recorder &other) = delete;
+    Recorder& operator=(const Recorder &other) = delete;
+
+    /**
+     * Record the start of the next game.
+     */
+    void game();
+
+    /**
+     * Record one of the initial critters of the game.
+     *
+     * @param index    index of the critter
+     * @param heading  its heading (as a Critter::Direction)
+     * @param column   its column
+     */
+    void critter(int index, int heading, int column);
+
+    /**
+     * Record a keystroke.
+     *
+     * @param frame  frame in which the key was read
+     * @param key    the key
+     */
+    void command(int frame, int key);
+
+    /**
+     * Record a painted scene (only if hashing frames).
+     *
+     * @param frame  frame number
+     * @param hash   hash of the scene
+     */
+    void frame(int frame, std::uint64_t hash);
+
+    /**
+     * Record the end of the current game and flush everything so far to the file.
+     *
+     * @param frame  last frame number of the game
+     */
+    void end(int frame);
+
+    /**
+     * @return true if FRAME records are being written
+     */
+    bool isHashingFrames() const;
+
+private:
+    std::ofstream out;
+    bool hashFrames;
+    int games;
+    std::chrono::steady_clock::time_point start;
+
+    void write(Recording::Type type, int aux, int frame, std::int64_t value);
+};
+
+/**
+ * @class Replay - read back a Recording
+ *
+ * The file is memory mapped and walked in order, so even a very large recording
+ * is never read into memory all at once.
+ */
+class Replay {
+public:
+    /**
+     * Open a recording for replay.
+     *
+     * @param filename  recording written by a Recorder
+     * @throws          runtime_error if the file can't be opened or isn't a recording
+     */
+    explicit Replay(const std::string &filename);
+
+    ~Replay();
+    Replay(const Replay &other) = delete;
+    Replay& operator=(const Replay &other) = delete;
+
+    /**
+     * @return  number of display rows in the recorded session
+     */
+    int getRowCount() const;
+
+    /**
+     * @return  number of display columns in the recorded session
+     */
+    int getColCount() const;
+
+    /**
+     * Make sure the games are about to be replayed the way they were set up when
+     * they were recorded (otherwise they would just play out differently).
+     *
+     * @param settings  how the replay is set up
+     * @throws          runtime_error naming the first setting that doesn't match
+     */
+    void check(const Recording::Settings &settings) const;
+
+    /**
+     * Check if there is another game to replay.
+     * Skips any leftovers of the current game.
+     *
+     * @return  true if next() will return the GAME record of another game
+     */
+    bool hasGame();
+
+    /**
+     * Look at the next record without consuming it.
+     *
+     * @return  next record, or nullptr if at end of recording
+     */
+    const Recording::Record* peek() const;
+
+    /**
+     * Consume the next record.
+     *
+     * @return  the record, or nullptr if at end of recording
+     */
+    const Recording::Record* next();
+
+private:
+    void *map;                          // the whole file
+    std::size_t length;                 // length of map in bytes
+    const Recording::Header *header;    // start of map
+    const Recording::Record *records;   // right after header
+    std::size_t count;                  // number of whole records in file
+    std::size_t cursor;                 // index of next record
+};
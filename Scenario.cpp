@@ -0,0 +1,187 @@
+/**
+ * @file Scenario.cpp - implementation of Scenario
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "Scenario.h"
+using namespace std;
+
+/*
+ * SplitMix64 finalizer: a well-mixed 64-bit hash of x.
+ */
+static uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+Scenario::Scenario() : seed(0), waves() {
+}
+
+void Scenario::load(const string &filename) {
+    ifstream in(filename);
+    if (!in)
+        throw runtime_error("cannot read scenario " + filename);
+    parse(in, filename);
+}
+
+/*
+ * Reads the whole scenario before changing anything, so a bad one leaves us as we were.
+ */
+void Scenario::parse(istream &in, const string &source) {
+    uint64_t parsedSeed = 0;
+    ListA<Wave> parsed;
+    string line;
+    int lineNumber = 0;
+    auto fail = [&](const string &what) {
+        throw invalid_argument(source + ":" + to_string(lineNumber) + ": " + what);
+    };
+    while (getline(in, line)) {
+        lineNumber++;
+        istringstream words(line);
+        string keyword;
+        if (!(words >> keyword) || keyword[0] == '#')
+            continue;
+        if (keyword == "seed") {
+            if (!(words >> parsedSeed))
+                fail("expected: seed NUMBER");
+        } else if (keyword == "wave") {
+            string kind;
+            Wave wave = {};
+            if (!(words >> kind >> wave.count) || wave.count < 0)
+                fail("expected: wave KIND COUNT");
+            if (kind == "inchworm")
+                wave.kind = INCHWORM;
+            else if (kind == "snake")
+                wave.kind = SNAKE;
+            else if (kind == "cannonball")
+                wave.kind = CANNONBALL;
+            else
+                fail("unknown kind of critter " + kind);
+            wave.rate = max(wave.count, 1);
+            string part;
+            while (words >> part) {
+                if (part == "at") {
+                    if (!(words >> wave.start) || wave.start < 0)
+                        fail("expected: at FRAME");
+                } else if (part == "rate") {
+                    if (!(words >> wave.rate) || wave.rate < 1)
+                        fail("expected: rate CRITTERS_PER_FRAME");
+                } else if (part == "region") {
+                    if (!(words >> wave.top >> wave.left >> wave.bottom >> wave.right)
+                            || wave.top > wave.bottom || wave.left > wave.right)
+                        fail("expected: region TOP LEFT BOTTOM RIGHT");
+                    wave.region = true;
+                } else if (part == "heading") {
+                    string heading;
+                    while (words >> heading) {
+                        if (heading == "north")
+                            wave.headings |= 1u << Critter::NORTH;
+                        else if (heading == "south")
+                            wave.headings |= 1u << Critter::SOUTH;
+                        else if (heading == "east")
+                            wave.headings |= 1u << Critter::EAST;
+                        else if (heading == "west")
+                            wave.headings |= 1u << Critter::WEST;
+                        else
+                            fail("unknown heading " + heading);
+                    }
+                } else {
+                    fail("unknown part of a wave " + part);
+                }
+            }
+            if (wave.headings == 0)
+                wave.headings = 1u << Critter::EAST;
+            parsed.append(wave);
+        } else {
+            fail("unknown keyword " + keyword);
+        }
+    }
+    seed = parsedSeed;
+    waves = std::move(parsed);
+}
+
+void Scenario::spawnsAt(int frame, int rows, int cols, ListA<Spawn> &out) const {
+    for (int w = 0; w < waves.size(); w++) {
+        const Wave &wave = waves[w];
+        if (frame < wave.start)
+            continue;
+        long first = static_cast<long>(frame - wave.start) * wave.rate;
+        if (first >= wave.count)
+            continue;
+        int top = 0, left = 0, bottom = max(0, rows - 5), right = cols - 1;  // above the cannon
+        if (wave.region) {
+            top = wave.top;
+            left = wave.left;
+            bottom = wave.bottom;
+            right = wave.right;
+        }
+        int headingCount = 0;
+        Critter::Direction headings[4];
+        for (int d = Critter::NORTH; d <= Critter::WEST; d++)
+            if (wave.headings & (1u << d))
+                headings[headingCount++] = static_cast<Critter::Direction>(d);
+
+        int last = static_cast<int>(min<long>(wave.count, first + wave.rate));
+        for (int k = static_cast<int>(first); k < last; k++) {
+            uint64_t h = mix(seed ^ mix((static_cast<uint64_t>(w) << 32) | static_cast<uint32_t>(k)));
+            Spawn spawn;
+            spawn.kind = wave.kind;
+            spawn.row = top + static_cast<int>((h & 0xffffffff) % static_cast<uint64_t>(bottom - top + 1));
+            spawn.col = left + static_cast<int>((h >> 32) % static_cast<uint64_t>(right - left + 1));
+            spawn.heading = headings[mix(h) % headingCount];
+            out.append(spawn);
+        }
+    }
+}
+
+int Scenario::getPopulation() const {
+    int population = 0;
+    for (const Wave &wave: waves)
+        population += wave.count;
+    return population;
+}
+
+int Scenario::getPopulation(Kind kind) const {
+    int population = 0;
+    for (const Wave &wave: waves)
+        if (wave.kind == kind)
+            population += wave.count;
+    return population;
+}
+
+int Scenario::getWaveCount() const {
+    return waves.size();
+}
+
+uint64_t Scenario::hash() const {
+    const uint64_t PRIME = 0x100000001b3;
+    uint64_t h = 0xcbf29ce484222325;
+    auto mix = [&h](uint64_t value) { h = (h ^ value) * PRIME; };
+    mix(seed);
+    for (const Wave &wave: waves) {
+        mix(wave.kind);
+        mix(wave.count);
+        mix(wave.start);
+        mix(wave.rate);
+        mix(wave.region);
+        if (wave.region) {
+            mix(wave.top);
+            mix(wave.left);
+            mix(wave.bottom);
+            mix(wave.right);
+        }
+        mix(wave.headings);
+    }
+    return h;
+}
+
+ostream& operator<<(ostream &out, const Scenario::Spawn &spawn) {
+    return out << spawn.kind << "(" << spawn.row << "," << spawn.col << "," << spawn.heading << ")";
+}
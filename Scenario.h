@@ -0,0 +1,135 @@
+/**
+ * @file Scenario.h - timed waves of critters, read from a text file
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include "ListA.h"
+#include "adt/Critter.h"
+
+/**
+ * @class Scenario - which critters show up in a game, where, and when
+ *
+ * A scenario is a seed and some waves. Each wave spawns a number of critters of
+ * one kind, so many per frame from its starting frame on, at spots picked at random
+ * in a region of the display. The random picks come from hashing the seed with
+ * the wave and the critter's number in it, not from a generator that runs as the
+ * game goes, so what spawns on a frame depends on nothing but the frame: games
+ * are reproducible, and replays and restored snapshots spawn just the same.
+ *
+ * The format is line-oriented; blank lines and lines starting with # are ignored:
+ *
+ *     seed 2018                      seed for the spawn spots (default 0)
+ *     wave inchworm 40               40 InchWorms...
+ *         at 10                      ...starting on frame 10 (default 0)
+ *         rate 4                     ...4 of them a frame (default all at once)
+ *         region 2 0 18 79           ...heads within rows 2-18, columns 0-79 (inclusive)
+ *         heading east west          ...each going one of these ways (default east)
+ *
+ * (the parts of a wave all go on one line, in any order). The kinds are inchworm,
+ * snake, and cannonball. The default region is the whole display above the cannon.
+ * For instance, the standard game is
+ *
+ *     wave inchworm 1 region 10 10 10 10
+ *     wave inchworm 1 region 15 15 15 15
+ *     wave snake 1 region 20 20 20 20
+ */
+class Scenario {
+public:
+    /**
+     * @enum Kind - kinds of critters a wave can have
+     */
+    enum Kind {
+        INCHWORM,
+        SNAKE,
+        CANNONBALL
+    };
+
+    /**
+     * @struct Spawn - one critter to make: its kind, where its (row,col) goes, and its heading
+     */
+    struct Spawn {
+        Kind kind;
+        int row, col;
+        Critter::Direction heading;
+        friend std::ostream& operator<<(std::ostream &out, const Spawn &spawn);
+    };
+
+    Scenario();
+
+    /**
+     * Read a scenario file (replacing whatever this scenario had).
+     *
+     * @param filename  scenario file
+     * @throws          runtime_error if the file can't be read,
+     *                  invalid_argument if it isn't a valid scenario
+     */
+    void load(const std::string &filename);
+
+    /**
+     * Read scenario text (replacing whatever this scenario had).
+     *
+     * @param in      where to read the text from
+     * @param source  name of where the text came from (for error messages)
+     * @throws        invalid_argument if the text isn't a valid scenario
+     */
+    void parse(std::istream &in, const std::string &source = "scenario");
+
+    /**
+     * Get the critters that spawn on a frame.
+     *
+     * @param frame  frame number (from 0, the game's first scene)
+     * @param rows   number of rows on the display
+     * @param cols   number of columns on the display
+     * @param out    where to append them (in wave order, then in order within the wave)
+     */
+    void spawnsAt(int frame, int rows, int cols, ListA<Spawn> &out) const;
+
+    /**
+     * @return  number of critters all the waves spawn, i.e., the most that can be alive at once
+     */
+    int getPopulation() const;
+
+    /**
+     * @param kind  kind of critter
+     * @return      number of critters of that kind that all the waves spawn
+     */
+    int getPopulation(Kind kind) const;
+
+    /**
+     * @return  number of waves
+     */
+    int getWaveCount() const;
+
+    /**
+     * Equal scenarios have equal hashes, so this is a cheap way to tell whether a
+     * recording was made with this scenario.
+     *
+     * @return  64-bit hash of the seed and the waves
+     */
+    std::uint64_t hash() const;
+
+private:
+    /**
+     * @struct Wave - one line of the scenario
+     */
+    struct Wave {
+        Kind kind;
+        int count;
+        int start;                          // first frame
+        int rate;                           // critters per frame
+        bool region;                        // false for the default region
+        int top, left, bottom, right;
+        unsigned headings;                  // bit 1 << d for each Direction d it can have
+        friend std::ostream& operator<<(std::ostream &out, const Wave &wave) {
+            return out << wave.kind << "*" << wave.count << "@" << wave.start << "/" << wave.rate;
+        }
+    };
+
+    std::uint64_t seed;
+    ListA<Wave> waves;
+};
@@ -0,0 +1,295 @@
+/**
+ * @file SelfCheck.cpp - implementation of selfCheck
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "SelfCheck.h"
+#include "Headless.h"
+#include "Menagerie.h"
+#include "QueueA.h"
+#include "QueueMPMC.h"
+#include "Recording.h"
+#include "Scenario.h"
+#include "SlotMap.h"
+#include "Snapshot.h"
+using namespace std;
+
+/*
+ * A failed check throws, so the rest of that check is skipped.
+ */
+static void check(bool ok, const string &what) {
+    if (!ok)
+        throw runtime_error(what);
+}
+
+static string scratchFile(const string &name) {
+    const char *dir = getenv("TMPDIR");
+    return string(dir != nullptr && *dir != '\0' ? dir : "/tmp") + "/menagerie-self-check-" + to_string(getpid())
+           + "-" + name;
+}
+
+/*
+ * A small game: worms along the top, cannonballs falling through them.
+ */
+static const char *const SCENARIO =
+        "seed 7\n"
+        "wave inchworm 150 region 2 0 30 150 heading east west\n"
+        "wave cannonball 400 region 20 0 45 159 rate 10\n";
+
+static const int ROWS = 50, COLS = 160;
+
+static void checkSame(const Snapshot &a, const Snapshot &b, const string &what) {
+    const Snapshot::Counters &x = a.counters, &y = b.counters;
+    check(x.rows == y.rows && x.cols == y.cols && x.eventCount == y.eventCount && x.frameCount == y.frameCount
+          && x.cannonballs == y.cannonballs && x.cannon == y.cannon, what + ": counters differ");
+    check(a.critters.size() == b.critters.size(), what + ": " + to_string(a.critters.size()) + " critters vs "
+                                                  + to_string(b.critters.size()));
+    for (int i = 0; i < a.critters.size(); i++) {
+        const Critter::State &s = a.critters[i], &t = b.critters[i];
+        check(s.kind == t.kind && s.heading == t.heading && s.phase == t.phase && s.row == t.row && s.col == t.col,
+              what + ": critter " + to_string(i) + " differs");
+    }
+    check(a.events.size() == b.events.size(), what + ": event queues differ in length");
+    for (int i = 0; i < a.events.size(); i++) {
+        const Snapshot::Event &e = a.events[i], &f = b.events[i];
+        check(e.type == f.type && e.data == f.data && e.critter == f.critter,
+              what + ": event " + to_string(i) + " differs");
+    }
+}
+
+static void loadScenario(Scenario &scenario) {
+    istringstream text(SCENARIO);
+    scenario.parse(text, "self-check scenario");
+}
+
+/*
+ * Play the scenario game on some threads to a frame and snapshot it.
+ */
+static void playTo(const Scenario &scenario, int threads, int frames, Snapshot &out) {
+    Headless h(ROWS, COLS);
+    Menagerie game(h);
+    game.setThreadCount(threads);
+    game.setScenario(&scenario);
+    game.setFrameLimit(frames);
+    game.play();
+    game.snapshot(out);
+}
+
+static void queueWrapAround() {
+    QueueA<int> q;
+    q.reserve(8);
+    int capacity = q.getCapacity();
+    for (int i = 0; i < capacity - 2; i++)
+        q.enqueue(i);
+    for (int i = 0; i < capacity / 2; i++)
+        q.dequeue();
+    // the front is now halfway along, so these wrap around to the start of the array and then make it grow
+    for (int i = capacity - 2; i < 3 * capacity; i++)
+        q.enqueue(i);
+    check(q.getCapacity() > capacity, "never grew");
+    check(q.size() == 3 * capacity - capacity / 2, "size " + to_string(q.size()));
+    QueueA<int> copy(q);
+    for (int i = 0; i < q.size(); i++)
+        check(q.get(i) == capacity / 2 + i && copy.get(i) == q.get(i), "get(" + to_string(i) + ") out of order");
+    for (int expected = capacity / 2; expected < 3 * capacity; expected++) {
+        check(!q.empty() && q.peek() == expected, "dequeued out of order at " + to_string(expected));
+        q.dequeue();
+    }
+    check(q.empty(), "not empty at the end");
+}
+
+static void slotMapStaleHandles() {
+    SlotMap<int> map;
+    SlotMap<int>::Handle a = map.insert(1), b = map.insert(2), c = map.insert(3);
+    check(map.erase(b), "erase failed");
+    check(!map.erase(b), "erased twice");
+    check(!map.contains(b) && map.find(b) == nullptr && map.indexOf(b) < 0, "erased handle still finds something");
+    SlotMap<int>::Handle d = map.insert(4);  // reuses b's slot
+    check(d.index == b.index && d != b, "slot not reused with a new generation");
+    check(map.find(b) == nullptr, "stale handle finds the slot's new value");
+    check(map.size() == 3 && *map.find(a) == 1 && *map.find(c) == 3 && *map.find(d) == 4, "live values lost");
+    check(!map.contains(SlotMap<int>::Handle()), "default handle refers to something");
+    map.clear();
+    check(map.size() == 0 && map.find(a) == nullptr && map.find(d) == nullptr, "handles survive clear");
+}
+
+/*
+ * Each producer enqueues an increasing run of its own values, so each consumer must see
+ * each producer's values in increasing order, and altogether all of them exactly once.
+ */
+static void queueMPMCStress() {
+    const int PRODUCERS = 4, CONSUMERS = 4, EACH = 100000;
+    QueueMPMC<long> q(64);
+    atomic<long> taken(0), sum(0);
+    atomic<bool> ordered(true);
+    vector<thread> threads;
+    for (int p = 0; p < PRODUCERS; p++)
+        threads.emplace_back([&q, p] {
+            for (long i = 0; i < EACH; i++)
+                while (!q.tryEnqueue(p * static_cast<long>(EACH) + i))
+                    this_thread::yield();
+        });
+    for (int c = 0; c < CONSUMERS; c++)
+        threads.emplace_back([&] {
+            vector<long> last(PRODUCERS, -1);
+            long value;
+            while (taken.load() < static_cast<long>(PRODUCERS) * EACH) {
+                if (!q.tryDequeue(value)) {
+                    this_thread::yield();
+                    continue;
+                }
+                taken.fetch_add(1);
+                sum.fetch_add(value);
+                int p = value / EACH;
+                if (value <= last[p])
+                    ordered.store(false);
+                last[p] = value;
+            }
+        });
+    for (thread &t: threads)
+        t.join();
+    long n = static_cast<long>(PRODUCERS) * EACH;
+    check(taken.load() == n, to_string(taken.load()) + " taken of " + to_string(n));
+    check(sum.load() == n * (n - 1) / 2, "values lost or duplicated");
+    check(ordered.load(), "a producer's values came out of order");
+    check(q.empty(), "not empty at the end");
+}
+
+/*
+ * Snapshot a game partway, save and load it, restore it into a new game, and play on:
+ * it has to end up where the game played straight through does.
+ */
+static void snapshotRoundTrip() {
+    Scenario scenario;
+    loadScenario(scenario);
+    Snapshot straight, partway, loaded, after;
+    playTo(scenario, 1, 40, straight);
+    playTo(scenario, 1, 20, partway);
+    string filename = scratchFile("snapshot");
+    partway.save(filename);
+    loaded.load(filename);
+    remove(filename.c_str());
+    checkSame(partway, loaded, "loaded");
+
+    Headless h(ROWS, COLS);
+    Menagerie game(h);
+    game.setScenario(&scenario);
+    game.restore(loaded);
+    game.snapshot(after);
+    checkSame(loaded, after, "restored");
+    game.setFrameLimit(40);
+    game.resume();
+    game.snapshot(after);
+    checkSame(straight, after, "played on");
+}
+
+static void threadDeterminism() {
+    Scenario scenario;
+    loadScenario(scenario);
+    Snapshot one, many;
+    playTo(scenario, 1, 60, one);
+    playTo(scenario, 4, 60, many);
+    checkSame(one, many, "1 thread vs 4");
+}
+
+/*
+ * A Headless display with someone at the keyboard: every so many scenes, a shot,
+ * a move, a turn, and now and then a quit.
+ */
+class Scripted : public Headless {
+public:
+    Scripted() : Headless(30, 60) {}
+
+    void paint(const PixelMatrix &pixels) {
+        Headless::paint(pixels);
+        long n = getPaintCount();
+        if (n % 7 == 0)
+            typeKey('h');
+        if (n % 11 == 0)
+            typeKey('i');
+        if (n % 23 == 0)
+            typeKey('g');
+        if (n % 150 == 0)
+            typeKey('q');
+    }
+};
+
+/*
+ * Record two games with scene hashes, then replay them on one thread and on several.
+ */
+static void recordReplay() {
+    string filename = scratchFile("recording");
+    {
+        Scripted player;
+        Menagerie game(player);
+        Recorder recorder(filename, player.getRowCount(), player.getColCount(), game.getSettings(), true);
+        game.record(&recorder);
+        game.play();
+        game.play();
+        game.record(nullptr);
+    }
+    for (int threads: {1, 4}) {
+        Replay replay(filename);
+        Headless h(replay.getRowCount(), replay.getColCount());
+        Menagerie game(h);
+        game.setThreadCount(threads);
+        game.replay(&replay);
+        int games = 0;
+        while (replay.hasGame()) {
+            game.play();
+            games++;
+        }
+        check(games == 2, to_string(games) + " games replayed on " + to_string(threads) + " thread(s)");
+        check(game.getReplayMismatches() == 0, to_string(game.getReplayMismatches()) + " mismatches on "
+                                               + to_string(threads) + " thread(s)");
+    }
+    Replay replay(filename);
+    Headless h(replay.getRowCount(), replay.getColCount());
+    Menagerie game(h);
+    game.setWorld(2 * replay.getRowCount(), 2 * replay.getColCount());
+    bool rejected = false;
+    try {
+        game.replay(&replay);
+    } catch (const runtime_error &) {
+        rejected = true;
+    }
+    remove(filename.c_str());
+    check(rejected, "replay in a world not rejected");
+}
+
+int selfCheck(ostream &out) {
+    struct Check {
+        const char *name;
+        void (*run)();
+    };
+    static const Check CHECKS[] = {
+        {"QueueA wrap-around", queueWrapAround},
+        {"SlotMap stale handles", slotMapStaleHandles},
+        {"QueueMPMC stress", queueMPMCStress},
+        {"Snapshot round trip", snapshotRoundTrip},
+        {"thread determinism", threadDeterminism},
+        {"record and replay", recordReplay},
+    };
+    int failures = 0;
+    for (const Check &c: CHECKS) {
+        try {
+            c.run();
+            out << "ok      " << c.name << endl;
+        } catch (const exception &e) {
+            out << "FAILED  " << c.name << ": " << e.what() << endl;
+            failures++;
+        }
+    }
+    out << failures << " of " << sizeof(CHECKS) / sizeof(CHECKS[0]) << " checks failed" << endl;
+    return failures;
+}
@@ -0,0 +1,22 @@
+/**
+ * @file SelfCheck.h - quick checks of the containers and of the game's determinism
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <iostream>
+
+/**
+ * Run the self-checks (menagerie --self-check) and report each one on a line:
+ * QueueA wrapping around as it grows, SlotMap handles going stale on erase,
+ * QueueMPMC under many producers and consumers at once, a Snapshot saved, loaded,
+ * and played on, a game played on one thread and on several, and games recorded
+ * and replayed (and a replay with the wrong settings rejected).
+ *
+ * Scratch files go in $TMPDIR (or /tmp) and are removed afterwards.
+ *
+ * @param out  where to report
+ * @return     number of checks that failed
+ */
+int selfCheck(std::ostream &out);
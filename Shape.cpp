@@ -0,0 +1,10 @@
+/**
+ * @file Shape.cpp - the standard colors for shape pixels
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include "Shape.h"
+
+const RGB *const ShapePixel::INKS[8] = {&RGB::BLACK, &RGB::WHITE, &RGB::RED, &RGB::GREEN,
+                                        &RGB::BLUE, &RGB::YELLOW, &RGB::CYAN, &RGB::MAGENTA};
@@ -0,0 +1,142 @@
+/**
+ * @file Shape.h - compile-time pixel tables for critters with fixed shapes
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include "adt/Critter.h"
+#include "PixelMatrix.h"
+
+/**
+ * @struct ShapePixel - one pixel of a Shape: where it is relative to the critter's
+ * (row, col) and which of the standard colors it is
+ */
+struct ShapePixel {
+    /**
+     * @enum Ink - the standard RGB colors, in the order of INKS
+     */
+    enum Ink : unsigned char { BLACK, WHITE, RED, GREEN, BLUE, YELLOW, CYAN, MAGENTA };
+
+    int dr, dc;     // row and column offsets
+    Ink ink;
+
+    /**
+     * @return  the pixel's color
+     */
+    const RGB& color() const { return *INKS[ink]; }
+
+    static const RGB *const INKS[8];    // INKS[ink] is the RGB for ink
+};
+
+/**
+ * @struct ShapeBounds - smallest rectangle holding every pixel of a Shape (inclusive offsets)
+ */
+struct ShapeBounds {
+    int top, left, bottom, right;
+};
+
+/**
+ * @struct Shape<N> - table of N pixels for one pose of a critter, plus its bounding box
+ *
+ * Shapes are meant to be built at compile time with makeShape and turned into
+ * the other headings with facing, so the whole table is a constexpr array and
+ * render is a straight loop over it:
+ *
+ *     static constexpr Shape<2> EAST = makeShape<2>({{0, 0, ShapePixel::RED}, {0, -1, ShapePixel::RED}});
+ *     static constexpr Shape<2> NORTH = EAST.facing(Critter::NORTH);
+ *     static_assert(NORTH.bounds.bottom == 1, "tail is below the head");
+ *
+ * @tparam N  number of pixels
+ */
+template <int N>
+struct Shape {
+    ShapePixel pixels[N];
+    ShapeBounds bounds;
+
+    /**
+     * Paint the shape onto a pixel matrix. Pixels that would land outside of it are ignored.
+     *
+     * @param pxm  pixel matrix to paint
+     * @param r    row the (0,0) offset lands on
+     * @param c    column the (0,0) offset lands on
+     */
+    void render(PixelMatrix &pxm, int r, int c) const {
+        for (const ShapePixel &p: pixels)
+            pxm.paint(r + p.dr, c + p.dc, &p.color(), 1);
+    }
+
+    /**
+     * Paint just the pixels of the shape that land in a clip rectangle (see Critter::renderClipped).
+     *
+     * @param pxm     pixel matrix to paint
+     * @param r       row the (0,0) offset lands on
+     * @param c       column the (0,0) offset lands on
+     * @param top     topmost row to paint (inclusive)
+     * @param left    leftmost column to paint (inclusive)
+     * @param bottom  bottommost row to paint (inclusive)
+     * @param right   rightmost column to paint (inclusive)
+     */
+    void render(PixelMatrix &pxm, int r, int c, int top, int left, int bottom, int right) const {
+        if (r + bounds.top > bottom || r + bounds.bottom < top || c + bounds.left > right || c + bounds.right < left)
+            return;
+        for (const ShapePixel &p: pixels) {
+            int row = r + p.dr, col = c + p.dc;
+            if (row >= top && row <= bottom && col >= left && col <= right)
+                pxm.paint(row, col, &p.color(), 1);
+        }
+    }
+
+    /**
+     * Turn an EASTbound shape to face another heading (e.g., offsets behind an
+     * EASTbound head are to its west, behind a NORTHbound one they are to its south).
+     *
+     * @param heading  heading to face
+     * @return         the turned shape, with its bounds
+     */
+    constexpr Shape<N> facing(Critter::Direction heading) const {
+        Shape<N> turned = *this;
+        for (int i = 0; i < N; i++) {
+            const ShapePixel &p = pixels[i];
+            switch (heading) {
+                case Critter::EAST:  turned.pixels[i] = {p.dr, p.dc, p.ink}; break;
+                case Critter::WEST:  turned.pixels[i] = {p.dr, -p.dc, p.ink}; break;
+                case Critter::NORTH: turned.pixels[i] = {-p.dc, p.dr, p.ink}; break;
+                case Critter::SOUTH: turned.pixels[i] = {p.dc, p.dr, p.ink}; break;
+            }
+        }
+        turned.bounds = boundsOf(turned.pixels);
+        return turned;
+    }
+
+    /**
+     * @param pixels  pixel table
+     * @return        smallest rectangle holding all of them
+     */
+    static constexpr ShapeBounds boundsOf(const ShapePixel (&pixels)[N]) {
+        ShapeBounds b = {pixels[0].dr, pixels[0].dc, pixels[0].dr, pixels[0].dc};
+        for (int i = 1; i < N; i++) {
+            b.top = pixels[i].dr < b.top ? pixels[i].dr : b.top;
+            b.bottom = pixels[i].dr > b.bottom ? pixels[i].dr : b.bottom;
+            b.left = pixels[i].dc < b.left ? pixels[i].dc : b.left;
+            b.right = pixels[i].dc > b.right ? pixels[i].dc : b.right;
+        }
+        return b;
+    }
+};
+
+/**
+ * Build a Shape (and its bounding box) from a pixel table.
+ *
+ * @tparam N     number of pixels
+ * @param pixels the pixels
+ * @return       the shape
+ */
+template <int N>
+constexpr Shape<N> makeShape(const ShapePixel (&pixels)[N]) {
+    Shape<N> shape = {};
+    for (int i = 0; i < N; i++)
+        shape.pixels[i] = pixels[i];
+    shape.bounds = Shape<N>::boundsOf(pixels);
+    return shape;
+}
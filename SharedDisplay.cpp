@@ -0,0 +1,191 @@
+/**
+ * @file SharedDisplay.cpp - implementation of SharedDisplay
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "SharedDisplay.h"
+using namespace std;
+
+static const char MAGIC[8] = {'M', 'N', 'G', 'R', 'S', 'H', 'M', '\0'};
+static const uint32_t VERSION = 1;
+
+static size_t frameSize(int rows, int cols) {
+    return static_cast<size_t>(rows) * cols * sizeof(RGB);
+}
+
+SharedDisplay::SharedDisplay(const string &name, int rowCount, int colCount)
+        : name(name), map(MAP_FAILED), length(0), layout(nullptr), frames(nullptr), pushedBack(), colors() {
+    if (rowCount <= 0 || colCount <= 0)
+        throw invalid_argument("shared display must have positive dimensions");
+    length = sizeof(Layout) + SLOTS * frameSize(rowCount, colCount);
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+        throw runtime_error("cannot create shared memory " + name);
+    if (ftruncate(fd, length) == 0)
+        map = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw runtime_error("cannot map shared memory " + name);
+    }
+
+    layout = new (map) Layout;
+    layout->version = VERSION;
+    layout->rows = rowCount;
+    layout->cols = colCount;
+    layout->slots = SLOTS;
+    layout->sequence.store(0);
+    layout->writing.store(0);
+    layout->keyHead.store(0);
+    layout->keyTail.store(0);
+    frames = reinterpret_cast<RGB *>(layout + 1);
+    // magic goes in last so a viewer never sees a half-initialized header
+    memcpy(layout->magic, MAGIC, sizeof(MAGIC));
+
+    const RGB *standard[] = {&RGB::BLACK, &RGB::RED, &RGB::GREEN, &RGB::YELLOW,
+                             &RGB::BLUE, &RGB::MAGENTA, &RGB::CYAN, &RGB::WHITE};
+    for (const RGB *color: standard)
+        colors.append(*color);
+}
+
+SharedDisplay::~SharedDisplay() {
+    munmap(map, length);
+    shm_unlink(name.c_str());
+}
+
+void SharedDisplay::getSize(int &rowCount, int &colCount) const {
+    rowCount = layout->rows;
+    colCount = layout->cols;
+}
+
+int SharedDisplay::getRowCount() const {
+    return layout->rows;
+}
+
+int SharedDisplay::getColCount() const {
+    return layout->cols;
+}
+
+/*
+ * Only the game writes frames, so the counters need no read-modify-write.
+ * The release fence pairs with the acquire fence in Viewer::isValid (seqlock style),
+ * and the release store makes the whole frame visible before the new sequence number.
+ */
+void SharedDisplay::paint(const PixelMatrix &pixels) {
+    int rows = layout->rows, cols = layout->cols, prows, pcols;
+    pixels.getSize(prows, pcols);
+    uint64_t seq = layout->sequence.load(memory_order_relaxed);
+    RGB *frame = frames + (seq % SLOTS) * rows * cols;
+    layout->writing.store(seq, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    int ncopy = min(cols, pcols);
+    for (int r = 0; r < rows; r++) {
+        RGB *row = frame + r * cols;
+        int start = 0;
+        if (r < prows) {
+            memcpy(static_cast<void *>(row), pixels.getRow(r), ncopy * sizeof(RGB));
+            start = ncopy;
+        }
+        for (int c = start; c < cols; c++)
+            row[c] = RGB::TRANSPARENT;
+    }
+    layout->sequence.store(seq + 1, memory_order_release);
+}
+
+void SharedDisplay::setText(int, int, const string &) {
+}
+
+bool SharedDisplay::hasKey() const {
+    return !pushedBack.empty()
+           || layout->keyTail.load(memory_order_relaxed) != layout->keyHead.load(memory_order_acquire);
+}
+
+int SharedDisplay::getKey() {
+    if (!pushedBack.empty()) {
+        int c = pushedBack.front();
+        pushedBack.pop_front();
+        return c;
+    }
+    uint32_t tail = layout->keyTail.load(memory_order_relaxed);
+    if (tail == layout->keyHead.load(memory_order_acquire))
+        throw logic_error("no keypress available");
+    int c = layout->keys[tail % KEY_RING];
+    layout->keyTail.store(tail + 1, memory_order_release);
+    return c;
+}
+
+void SharedDisplay::pushbackKey(int c) {
+    pushedBack.push_front(c);
+}
+
+const ListA<RGB>& SharedDisplay::getColors() const {
+    return colors;
+}
+
+SharedDisplay::Viewer::Viewer(const string &name) : map(MAP_FAILED), length(0), layout(nullptr), frames(nullptr) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+        throw runtime_error("no shared display " + name);
+    struct stat st;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(Layout)) {
+        length = st.st_size;
+        map = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED)
+        throw runtime_error("cannot map shared display " + name);
+    layout = static_cast<Layout *>(map);
+    if (memcmp(layout->magic, MAGIC, sizeof(MAGIC)) != 0 || layout->version != VERSION
+            || length < sizeof(Layout) + layout->slots * frameSize(layout->rows, layout->cols)) {
+        munmap(map, length);
+        throw runtime_error(name + " is not a shared display");
+    }
+    frames = reinterpret_cast<const RGB *>(layout + 1);
+}
+
+SharedDisplay::Viewer::~Viewer() {
+    munmap(map, length);
+}
+
+int SharedDisplay::Viewer::getRowCount() const {
+    return layout->rows;
+}
+
+int SharedDisplay::Viewer::getColCount() const {
+    return layout->cols;
+}
+
+uint64_t SharedDisplay::Viewer::getSequence() const {
+    return layout->sequence.load(memory_order_acquire);
+}
+
+const RGB* SharedDisplay::Viewer::getFrame(uint64_t frame) const {
+    return frames + (frame % layout->slots) * layout->rows * layout->cols;
+}
+
+/*
+ * The game overwrites frame's slot when it writes frame + slots. If we read any pixel
+ * from that, the fence guarantees we also see writing at frame + slots or later.
+ */
+bool SharedDisplay::Viewer::isValid(uint64_t frame) const {
+    atomic_thread_fence(memory_order_acquire);
+    return layout->writing.load(memory_order_relaxed) < frame + layout->slots;
+}
+
+bool SharedDisplay::Viewer::sendKey(int c) {
+    uint32_t head = layout->keyHead.load(memory_order_relaxed);
+    if (head - layout->keyTail.load(memory_order_acquire) >= KEY_RING)
+        return false;
+    layout->keys[head % KEY_RING] = c;
+    layout->keyHead.store(head + 1, memory_order_release);
+    return true;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file SharedDisplay.h - Display that publishes frames in POSIX shared memory
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include "adt/Display.h"
+
+/**
+ * @class SharedDisplay - Display implementation backed by a shared-memory frame ring
+ *
+ * Each paint is copied into the next slot of a ring of frame buffers in a POSIX
+ * shared-memory object, and then the sequence counter is bumped. A viewer process
+ * (see SharedDisplay::Viewer) maps the same object and reads the frames right where
+ * they are, with no copying or serialization. Keys typed in the viewer come back
+ * through a single-producer/single-consumer ring in the same object.
+ *
+ * The game process does no terminal I/O at all.
+ *
+ * A frame buffer is rows*cols RGB structs in row-major order, i.e., the same layout
+ * as the rows of a PixelMatrix one after another.
+ */
+class SharedDisplay : public Display {
+public:
+    /**
+     * number of frame buffers in the ring
+     */
+    static const int SLOTS = 3;
+
+    /**
+     * number of keys the viewer can have sent that the game hasn't read yet
+     */
+    static const int KEY_RING = 64;
+
+    /**
+     * @struct Layout - start of the shared-memory object; the SLOTS frame buffers follow it
+     */
+    struct Layout {
+        char magic[8];                          // "MNGRSHM"
+        std::uint32_t version;                  // 1
+        std::int32_t rows, cols;                // size of each frame
+        std::int32_t slots;                     // SLOTS
+        std::atomic<std::uint64_t> sequence;    // number of frames published; frame n is in slot n % slots
+        std::atomic<std::uint64_t> writing;     // frame being (or last) written
+        std::atomic<std::uint32_t> keyHead;     // next key slot the viewer will write
+        std::atomic<std::uint32_t> keyTail;     // next key slot the game will read
+        std::int32_t keys[KEY_RING];            // ring of keys from the viewer
+    };
+
+    /**
+     * Create the shared-memory object (replacing any old one with the same name).
+     *
+     * @param name      POSIX shared-memory name, e.g. "/menagerie"
+     * @param rowCount  number of rows
+     * @param colCount  number of columns
+     * @throws          runtime_error if the object can't be created
+     */
+    SharedDisplay(const std::string &name, int rowCount = 24, int colCount = 80);
+
+    /**
+     * Unmaps and removes the shared-memory object.
+     */
+    ~SharedDisplay();
+    SharedDisplay(const SharedDisplay &other) = delete;
+    SharedDisplay& operator=(const SharedDisplay &other) = delete;
+
+    void getSize(int &rowCount, int &colCount) const;
+    int getRowCount() const;
+    int getColCount() const;
+
+    /**
+     * Copy the pixels into the next frame buffer and publish it.
+     * Pixels outside the display are ignored; display pixels outside of pixels are transparent.
+     *
+     * @param pixels  the pixel map with the desired colors for each character cell
+     */
+    void paint(const PixelMatrix &pixels);
+
+    /**
+     * Text isn't shared with the viewer, so this does nothing.
+     */
+    void setText(int r, int c, const std::string &text);
+
+    bool hasKey() const;
+
+    /**
+     * Get the next key pushed back, or else sent by the viewer. Never blocks.
+     *
+     * @return  the key
+     * @throws  logic_error if there is no key waiting
+     */
+    int getKey();
+
+    void pushbackKey(int c);
+
+    /**
+     * The colors are the eight fully-saturated ones from RGB. (Frames hold full RGB anyway.)
+     *
+     * @return  list of the supported colors
+     */
+    const ListA<RGB>& getColors() const;
+
+    /**
+     * @class Viewer - the other end: maps a SharedDisplay created by another process
+     */
+    class Viewer {
+    public:
+        /**
+         * Attach to an existing SharedDisplay.
+         *
+         * @param name  POSIX shared-memory name the SharedDisplay was created with
+         * @throws      runtime_error if there is no such SharedDisplay
+         */
+        explicit Viewer(const std::string &name);
+        ~Viewer();
+        Viewer(const Viewer &other) = delete;
+        Viewer& operator=(const Viewer &other) = delete;
+
+        int getRowCount() const;
+        int getColCount() const;
+
+        /**
+         * Get the sequence number of the latest frame published.
+         *
+         * @return  number of frames published so far (0 if none yet)
+         */
+        std::uint64_t getSequence() const;
+
+        /**
+         * Get a frame in place. Frame seq-1 is the latest of seq published frames.
+         *
+         * @param frame  frame number, which must be one of the last SLOTS published
+         * @return       rows*cols pixels in row-major order
+         */
+        const RGB* getFrame(std::uint64_t frame) const;
+
+        /**
+         * Check that a frame returned by getFrame hasn't been overwritten by the game
+         * since. Call this after reading the pixels to know they were all from one frame.
+         *
+         * @param frame  frame number
+         * @return       true if the frame's buffer has not been reused yet
+         */
+        bool isValid(std::uint64_t frame) const;
+
+        /**
+         * Send a key to the game.
+         *
+         * @param c  key
+         * @return   false if the key ring is full (the game isn't reading keys)
+         */
+        bool sendKey(int c);
+
+    private:
+        void *map;
+        std::size_t length;
+        Layout *layout;
+        const RGB *frames;
+    };
+
+private:
+    std::string name;
+    void *map;
+    std::size_t length;
+    Layout *layout;
+    RGB *frames;
+    std::deque<int> pushedBack;
+    ListA<RGB> colors;
+};
@@ -0,0 +1,304 @@
+/**
+ * @file SlotMap.h - Generational slot map: stable handles to densely stored values
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include "ListA.h"
+
+/**
+ * @class SlotMap<T> - values kept densely packed, referred to by generational handles.
+ *
+ * insert gives back a Handle that stays good until that value is erased, no matter
+ * what else is inserted or erased. Once erased, the handle (and every copy of it)
+ * is stale: find returns nullptr for it, even after the slot is reused for
+ * something else, because each reuse bumps the slot's generation.
+ *
+ * The values themselves are kept in a dense array with no holes, so iterating over
+ * all of them with get(i) for 0 <= i < size() only ever sees live ones. Erasing
+ * moves the last value into the hole, so dense indices are not stable (handles are).
+ *
+ * insert:  O(1) amortized
+ * erase:   O(1)
+ * find:    O(1)
+ * get(i):  O(1)
+ *
+ * @tparam T  value type, meant to be small like a pointer (values get copied when
+ *            the dense array is compacted)
+ */
+template <typename T>
+class SlotMap {
+public:
+    /**
+     * @struct Handle - stable reference to a value in the SlotMap.
+     * A default-constructed Handle never refers to anything.
+     */
+    struct Handle {
+        std::uint32_t index;        // slot number
+        std::uint32_t generation;   // which use of the slot (0 is never used)
+
+        Handle() : index(0), generation(0) {}
+        Handle(std::uint32_t index, std::uint32_t generation) : index(index), generation(generation) {}
+        bool operator==(const Handle &other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const Handle &other) const { return !(*this == other); }
+        friend std::ostream& operator<<(std::ostream &out, const Handle &h) {
+            return out << h.index << "." << h.generation;
+        }
+    };
+
+    SlotMap();
+
+    /**
+     * Add a value.
+     *
+     * @param value  value to add
+     * @return       handle to it
+     */
+    Handle insert(const T &value);
+
+    /**
+     * Remove the value the handle refers to.
+     *
+     * @param h  handle from insert
+     * @return   true if h was live (and now isn't), false if it was already stale
+     */
+    bool erase(Handle h);
+
+    /**
+     * Look up a value by handle.
+     *
+     * @param h  handle from insert
+     * @return   pointer to the value, or nullptr if h is stale (good until the next insert or erase)
+     */
+    T *find(Handle h);
+    const T *find(Handle h) const;
+
+    /**
+     * @param h  handle from insert
+     * @return   true if h still refers to a value
+     */
+    bool contains(Handle h) const;
+
+    /**
+     * @return  number of live values
+     */
+    int size() const;
+
+    /**
+     * Get a value by its dense index.
+     *
+     * @param i  0 <= i < size()
+     * @return   the value
+     * @throws   out_of_range if i is invalid
+     */
+    const T& get(int i) const;
+
+    /**
+     * Get a value by its dense index with no bounds check (unlike get).
+     *
+     * @param i  0 <= i < size() (not checked)
+     * @return   the value
+     */
+    const T& operator[](int i) const;
+
+    /**
+     * Iteration over the live values in dense order (invalidated by insert and erase).
+     */
+    typedef const T *const_iterator;
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /**
+     * Get the handle for the value at a dense index.
+     *
+     * @param i  0 <= i < size()
+     * @return   handle to get(i)
+     * @throws   out_of_range if i is invalid
+     */
+    Handle handleAt(int i) const;
+
+    /**
+     * Find where a handle's value is in the dense order.
+     *
+     * @param h  handle from insert
+     * @return   i such that handleAt(i) == h, or -1 if h is stale
+     */
+    int indexOf(Handle h) const;
+
+    /**
+     * Remove all the values. All outstanding handles become stale.
+     */
+    void clear();
+
+    /**
+     * Make room for n values without reallocating.
+     *
+     * @param n  number of values
+     */
+    void reserve(int n);
+
+    /**
+     * @return  bytes of storage held for slots and values (not counting what the values point to)
+     */
+    std::size_t getBytesReserved() const;
+
+private:
+    /**
+     * @struct Slot - where a handle's index leads to
+     */
+    struct Slot {
+        std::uint32_t generation;   // current generation; odd while in use, even while free
+        int dense;                  // index into values while in use, next free slot (or -1) while free
+        friend std::ostream& operator<<(std::ostream &out, const Slot &slot) {
+            return out << slot.generation << ":" << slot.dense;
+        }
+    };
+    ListA<Slot> slots;
+    ListA<T> values;        // live values, densely packed
+    ListA<int> owners;      // owners.get(i) is the slot index for values.get(i)
+    int freeHead;           // first free slot, or -1
+
+    bool live(Handle h) const;
+};
+
+template <typename T>
+SlotMap<T>::SlotMap() : slots(), values(), owners(), freeHead(-1) {
+}
+
+template <typename T>
+bool SlotMap<T>::live(Handle h) const {
+    return h.index < static_cast<std::uint32_t>(slots.size()) && slots[h.index].generation == h.generation;
+}
+
+template <typename T>
+typename SlotMap<T>::Handle SlotMap<T>::insert(const T &value) {
+    int index;
+    Slot slot;
+    if (freeHead >= 0) {
+        index = freeHead;
+        slot = slots.get(index);
+        freeHead = slot.dense;
+        slot.generation++;  // even -> odd: in use again, and old handles are stale
+    } else {
+        index = slots.size();
+        slot.generation = 1;
+        slots.append(slot);
+    }
+    slot.dense = values.append(value);
+    owners.append(index);
+    slots.set(index, slot);
+    return Handle(index, slot.generation);
+}
+
+/*
+ * Fill the hole with the last value so the dense array stays packed.
+ */
+template <typename T>
+bool SlotMap<T>::erase(Handle h) {
+    if (!live(h))
+        return false;
+    Slot slot = slots.get(h.index);
+    int hole = slot.dense;
+    int last = values.size() - 1;
+    if (hole != last) {
+        values.set(hole, values.get(last));
+        int moved = owners.get(last);
+        owners.set(hole, moved);
+        Slot movedSlot = slots.get(moved);
+        movedSlot.dense = hole;
+        slots.set(moved, movedSlot);
+    }
+    values.remove();
+    owners.remove();
+    slot.generation++;  // odd -> even: free
+    slot.dense = freeHead;
+    slots.set(h.index, slot);
+    freeHead = h.index;
+    return true;
+}
+
+template <typename T>
+T *SlotMap<T>::find(Handle h) {
+    return live(h) ? &values[slots[h.index].dense] : nullptr;
+}
+
+template <typename T>
+const T *SlotMap<T>::find(Handle h) const {
+    return live(h) ? &values[slots[h.index].dense] : nullptr;
+}
+
+template <typename T>
+bool SlotMap<T>::contains(Handle h) const {
+    return live(h);
+}
+
+template <typename T>
+int SlotMap<T>::size() const {
+    return values.size();
+}
+
+template <typename T>
+const T& SlotMap<T>::get(int i) const {
+    return values.get(i);
+}
+
+template <typename T>
+const T& SlotMap<T>::operator[](int i) const {
+    return values[i];
+}
+
+template <typename T>
+const T *SlotMap<T>::begin() const {
+    return values.begin();
+}
+
+template <typename T>
+const T *SlotMap<T>::end() const {
+    return values.end();
+}
+
+template <typename T>
+typename SlotMap<T>::Handle SlotMap<T>::handleAt(int i) const {
+    int index = owners.get(i);
+    return Handle(index, slots.get(index).generation);
+}
+
+/*
+ * Free every slot in use (rather than forgetting the slots) so that generations keep
+ * counting up and no outstanding handle can come back to life.
+ */
+template <typename T>
+void SlotMap<T>::clear() {
+    for (int i = 0; i < owners.size(); i++) {
+        int index = owners.get(i);
+        Slot slot = slots.get(index);
+        slot.generation++;
+        slot.dense = freeHead;
+        slots.set(index, slot);
+        freeHead = index;
+    }
+    values.clear();
+    owners.clear();
+}
+
+template <typename T>
+int SlotMap<T>::indexOf(Handle h) const {
+    return live(h) ? slots[h.index].dense : -1;
+}
+
+template <typename T>
+std::size_t SlotMap<T>::getBytesReserved() const {
+    return slots.getCapacity() * sizeof(Slot) + values.getCapacity() * sizeof(T) + owners.getCapacity() * sizeof(int);
+}
+
+template <typename T>
+void SlotMap<T>::reserve(int n) {
+    slots.reserve(n);
+    values.reserve(n);
+    owners.reserve(n);
+}
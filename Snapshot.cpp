@@ -0,0 +1,89 @@
+/**
+ * @file Snapshot.cpp - implementation of Snapshot
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "Snapshot.h"
+#include "Cannon.h"
+#include "Cannonball.h"
+#include "InchWorm.h"
+using namespace std;
+
+const char Snapshot::MAGIC[8] = {'M', 'N', 'G', 'R', 'S', 'N', 'P', '\0'};
+
+Snapshot::Snapshot() : counters(), critters(), events() {
+}
+
+Critter *Snapshot::make(const Critter::State &state) {
+    if (state.heading > Critter::WEST)
+        throw invalid_argument("snapshot has a critter with no such heading");
+    switch (state.kind) {
+        case INCHWORM:
+            return new InchWorm(state);
+        case CANNON:
+            return new Cannon(state);
+        case CANNONBALL:
+            return new Cannonball(state);
+        default:
+            throw invalid_argument("snapshot has an unknown kind of critter");
+    }
+}
+
+void Snapshot::save(const string &filename) const {
+    ofstream out(filename, ios::binary | ios::trunc);
+    if (!out)
+        throw runtime_error("cannot open snapshot " + filename);
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.stateSize = sizeof(Critter::State);
+    header.eventSize = sizeof(Event);
+    header.critterCount = critters.size();
+    header.eventCount = events.size();
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(&counters), sizeof(counters));
+    out.write(reinterpret_cast<const char *>(critters.data()), critters.size() * sizeof(Critter::State));
+    out.write(reinterpret_cast<const char *>(events.data()), events.size() * sizeof(Event));
+    if (!out.flush())
+        throw runtime_error("cannot write snapshot " + filename);
+}
+
+void Snapshot::load(const string &filename) {
+    ifstream in(filename, ios::binary);
+    if (!in)
+        throw runtime_error("cannot open snapshot " + filename);
+    Header header;
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header))
+            || memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0 || header.version != VERSION
+            || header.stateSize != sizeof(Critter::State) || header.eventSize != sizeof(Event)
+            || header.critterCount < 0 || header.eventCount < 0)
+        throw runtime_error(filename + " is not a snapshot");
+
+    // size the lists, then read straight into them
+    critters.clear();
+    events.clear();
+    critters.reserve(header.critterCount);
+    events.reserve(header.eventCount);
+    for (int i = 0; i < header.critterCount; i++)
+        critters.append(Critter::State());
+    for (int i = 0; i < header.eventCount; i++)
+        events.append(Event());
+    in.read(reinterpret_cast<char *>(&counters), sizeof(counters));
+    in.read(reinterpret_cast<char *>(critters.data()), critters.size() * sizeof(Critter::State));
+    in.read(reinterpret_cast<char *>(events.data()), events.size() * sizeof(Event));
+    if (!in)
+        throw runtime_error("snapshot " + filename + " is cut short");
+}
+
+ostream& operator<<(ostream &out, const Snapshot::Event &event) {
+    return out << event.type << ":" << event.data << ":" << event.critter;
+}
+
+ostream& operator<<(ostream &out, const Critter::State &state) {
+    return out << static_cast<int>(state.kind) << ":" << state.row << "," << state.col << ","
+               << static_cast<Critter::Direction>(state.heading) << "," << static_cast<int>(state.phase);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file Snapshot.h - a Menagerie game's complete state, as flat plain data
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include "ListA.h"
+#include "adt/Critter.h"
+
+/**
+ * @class Snapshot - everything needed to put a Menagerie game back where it was
+ *
+ * Menagerie::snapshot fills one in and Menagerie::restore puts the game back, so
+ * a position can be played out many different ways, or a long run checkpointed
+ * (with save and load). It is all fixed-size records: the critters' States, the
+ * event queue, and the game's counters. No critter is copied or printed, taking
+ * a snapshot into one that was used before doesn't allocate, and save and load
+ * are a few block writes and reads.
+ *
+ * The critters are in the game's dense order, and the events refer to them by
+ * that index (or -1 for a critter that has died since its MOVE was queued), so
+ * a restored game plays out exactly as the original would have.
+ *
+ * The file is a Header, the Counters, the critters, then the events.
+ */
+class Snapshot {
+public:
+    /**
+     * @enum Kind - the kinds of critters that can be snapshotted (Critter::State::kind)
+     */
+    enum Kind : std::uint8_t {
+        UNKNOWN,    // never in a snapshot: getState gives false for these
+        INCHWORM,
+        CANNON,
+        CANNONBALL
+    };
+
+    /**
+     * @struct Counters - the game's own state
+     */
+    struct Counters {
+        std::int32_t rows, cols;        // size of the world played in (the display, if no world)
+        std::int32_t eventCount;
+        std::int32_t lastMovement;
+        std::int32_t frameCount;
+        std::int32_t cannonballs;       // cannonballs shot (so CANNON_BALLS less this are left)
+        std::int32_t skippedFrames;
+        std::int32_t frameSkipRun;
+        std::int32_t cannon;            // index of the user's Cannon in critters, or -1 if it's dead
+        std::int32_t cameraRow;         // where the viewport is in the world (0,0 if no world)
+        std::int32_t cameraCol;
+    };
+
+    /**
+     * @struct Event - one event on the queue
+     */
+    struct Event {
+        std::int32_t type;      // Menagerie's EventType
+        std::int32_t data;      // keystroke, for a COMMAND
+        std::int32_t critter;   // index in critters of the one to move, for a MOVE (-1 if it's dead)
+        friend std::ostream& operator<<(std::ostream &out, const Event &event);
+    };
+
+    /**
+     * @struct Header - start of every snapshot file
+     */
+    struct Header {
+        char magic[8];                  // MAGIC
+        std::uint32_t version;          // VERSION
+        std::uint32_t stateSize;        // sizeof(Critter::State)
+        std::uint32_t eventSize;        // sizeof(Event)
+        std::int32_t critterCount;
+        std::int32_t eventCount;
+    };
+
+    static const char MAGIC[8];
+    static const std::uint32_t VERSION = 2;
+
+    Counters counters;
+    ListA<Critter::State> critters;
+    ListA<Event> events;
+
+    Snapshot();
+
+    /**
+     * Make a critter back from its state.
+     *
+     * @param state  state from Critter::getState
+     * @return       new critter (the caller owns it)
+     * @throws       invalid_argument if the state isn't one of a known Kind
+     */
+    static Critter *make(const Critter::State &state);
+
+    /**
+     * Write the snapshot to a file (overwrites any existing file).
+     *
+     * @param filename  where to write it
+     * @throws          runtime_error if the file can't be written
+     */
+    void save(const std::string &filename) const;
+
+    /**
+     * Replace this snapshot with one written by save.
+     *
+     * @param filename  snapshot file
+     * @throws          runtime_error if the file can't be read or isn't a snapshot
+     */
+    void load(const std::string &filename);
+};
+
+/**
+ * Print a critter's state, e.g., for logging (kind:row,col,heading,phase).
+ *
+ * @param out    where to print
+ * @param state  the state
+ * @return       out, at the end
+ */
+std::ostream& operator<<(std::ostream &out, const Critter::State &state);
@@ -0,0 +1,64 @@
+/**
+ * @file Sprite.cpp - implementation of Sprite
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <stdexcept>
+#include "Sprite.h"
+using namespace std;
+
+Sprite::Sprite() : rows(0), cols(0), anchorRow(0), anchorCol(0), opaque(), runs() {
+}
+
+/*
+ * Scan each row of the block for runs of opaque pixels and pack them up.
+ * Coordinates are stored relative to the anchor so stamp doesn't have to adjust them.
+ */
+Sprite::Sprite(int rows, int cols, int anchorRow, int anchorCol, const ListA<RGB> &pixels)
+        : rows(rows), cols(cols), anchorRow(anchorRow), anchorCol(anchorCol), opaque(), runs() {
+    if (rows < 0 || cols < 0 || pixels.size() != rows * cols)
+        throw invalid_argument("sprite pixels don't fill its block");
+    for (int r = 0; r < rows; r++) {
+        int c = 0;
+        while (c < cols) {
+            if (pixels[r * cols + c].transparent) {
+                c++;
+                continue;
+            }
+            Run run;
+            run.row = r - anchorRow;
+            run.col = c - anchorCol;
+            run.start = opaque.size();
+            while (c < cols && !pixels[r * cols + c].transparent)
+                opaque.append(pixels[r * cols + c++]);
+            run.length = opaque.size() - run.start;
+            runs.append(run);
+        }
+    }
+}
+
+void Sprite::stamp(PixelMatrix &pxm, int row, int col) const {
+    for (const Run &run: runs)
+        pxm.paint(row + run.row, col + run.col, opaque.data() + run.start, run.length);
+}
+
+int Sprite::getRowCount() const {
+    return rows;
+}
+
+int Sprite::getColCount() const {
+    return cols;
+}
+
+int Sprite::getAnchorRow() const {
+    return anchorRow;
+}
+
+int Sprite::getAnchorCol() const {
+    return anchorCol;
+}
+
+int Sprite::getPixelCount() const {
+    return opaque.size();
+}
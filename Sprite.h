@@ -0,0 +1,79 @@
+/**
+ * @file Sprite.h - packed block of pixels that can be stamped onto a PixelMatrix
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <iostream>
+#include "ListA.h"
+#include "PixelMatrix.h"
+
+/**
+ * @class Sprite - a critter's picture in one pose
+ *
+ * A rectangular block of pixels, some of them transparent, with an anchor point
+ * that says which pixel lands on the (row, col) it is stamped at (so, e.g., an
+ * InchWorm's anchor is its head). The anchor doesn't have to be inside the block.
+ *
+ * The transparency mask is applied when the sprite is built: only the opaque
+ * pixels are kept, packed together as horizontal runs. Stamping is then just a
+ * bulk copy per run, clipped to the pixel matrix once per run.
+ */
+class Sprite {
+public:
+    /**
+     * An empty sprite (stamps nothing).
+     */
+    Sprite();
+
+    /**
+     * Build a sprite from a block of pixels.
+     *
+     * @param rows       number of rows in the block
+     * @param cols       number of columns in the block
+     * @param anchorRow  row within the block that lands on the stamped row
+     * @param anchorCol  column within the block that lands on the stamped column
+     * @param pixels     rows*cols pixels in row-major order (transparent ones are left out)
+     * @throws           invalid_argument if pixels isn't rows*cols long
+     */
+    Sprite(int rows, int cols, int anchorRow, int anchorCol, const ListA<RGB> &pixels);
+
+    /**
+     * Paint the sprite's opaque pixels onto a pixel matrix. Pixels that would land
+     * outside of it are ignored.
+     *
+     * @param pxm  pixel matrix to paint
+     * @param row  row the anchor lands on
+     * @param col  column the anchor lands on
+     */
+    void stamp(PixelMatrix &pxm, int row, int col) const;
+
+    int getRowCount() const;
+    int getColCount() const;
+    int getAnchorRow() const;
+    int getAnchorCol() const;
+
+    /**
+     * @return  number of opaque pixels
+     */
+    int getPixelCount() const;
+
+private:
+    /**
+     * @struct Run - horizontal run of opaque pixels
+     */
+    struct Run {
+        int row, col;   // where the run starts, relative to the anchor
+        int length;     // number of pixels
+        int start;      // index of its first pixel in opaque
+        friend std::ostream& operator<<(std::ostream &out, const Run &run) {
+            return out << run.row << "," << run.col << "x" << run.length;
+        }
+    };
+
+    int rows, cols;
+    int anchorRow, anchorCol;
+    ListA<RGB> opaque;  // all the opaque pixels, run after run
+    ListA<Run> runs;
+};
@@ -0,0 +1,138 @@
+/**
+ * @file SpriteSheet.cpp - implementation of SpriteSheet
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "SpriteSheet.h"
+using namespace std;
+
+SpriteSheet::SpriteSheet() : sprites() {
+}
+
+SpriteSheet& SpriteSheet::standard() {
+    static SpriteSheet sheet;
+    return sheet;
+}
+
+void SpriteSheet::load(const string &filename) {
+    ifstream in(filename);
+    if (!in)
+        throw runtime_error("cannot read sprite sheet " + filename);
+    parse(in, filename);
+}
+
+/*
+ * Reads the whole sheet before changing anything, so a bad sheet leaves us as we were.
+ */
+void SpriteSheet::parse(istream &in, const string &source) {
+    RGB palette[128];
+    palette[static_cast<int>('K')] = RGB::BLACK;
+    palette[static_cast<int>('W')] = RGB::WHITE;
+    palette[static_cast<int>('R')] = RGB::RED;
+    palette[static_cast<int>('G')] = RGB::GREEN;
+    palette[static_cast<int>('B')] = RGB::BLUE;
+    palette[static_cast<int>('Y')] = RGB::YELLOW;
+    palette[static_cast<int>('C')] = RGB::CYAN;
+    palette[static_cast<int>('M')] = RGB::MAGENTA;
+    bool defined[128] = {};
+    for (char letter: string("KWRGBYCM"))
+        defined[static_cast<int>(letter)] = true;
+
+    map<string, Sprite> parsed;
+    string line;
+    int lineNumber = 0;
+    auto fail = [&](const string &what) {
+        throw invalid_argument(source + ":" + to_string(lineNumber) + ": " + what);
+    };
+    while (getline(in, line)) {
+        lineNumber++;
+        istringstream words(line);
+        string keyword;
+        if (!(words >> keyword) || keyword[0] == '#')
+            continue;
+        if (keyword == "color") {
+            string letter;
+            int red, green, blue;
+            if (!(words >> letter >> red >> green >> blue) || letter.size() != 1 || letter == "."
+                    || static_cast<unsigned char>(letter[0]) >= 128
+                    || red < 0 || red >= RGB::LEVELS || green < 0 || green >= RGB::LEVELS
+                    || blue < 0 || blue >= RGB::LEVELS)
+                fail("expected: color LETTER RED GREEN BLUE");
+            palette[static_cast<int>(letter[0])] = RGB(red, green, blue);
+            defined[static_cast<int>(letter[0])] = true;
+        } else if (keyword == "sprite") {
+            string name;
+            int anchorRow, anchorCol;
+            if (!(words >> name >> anchorRow >> anchorCol))
+                fail("expected: sprite NAME ANCHOR_ROW ANCHOR_COL");
+            ListA<RGB> pixels;
+            int rows = 0, cols = -1;
+            for (;;) {
+                if (!getline(in, line))
+                    fail("sprite " + name + " has no end");
+                lineNumber++;
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                if (line == "end")
+                    break;
+                if (cols >= 0 && static_cast<int>(line.size()) != cols)
+                    fail("sprite " + name + " rows are not all the same length");
+                cols = line.size();
+                for (char letter: line) {
+                    if (letter == '.')
+                        pixels.append(RGB::TRANSPARENT);
+                    else if (static_cast<unsigned char>(letter) < 128 && defined[static_cast<int>(letter)])
+                        pixels.append(palette[static_cast<int>(letter)]);
+                    else
+                        fail(string("undefined color ") + letter);
+                }
+                rows++;
+            }
+            parsed[name] = Sprite(rows, max(cols, 0), anchorRow, anchorCol, pixels);
+        } else {
+            fail("unknown keyword " + keyword);
+        }
+    }
+    for (auto &entry: parsed)
+        sprites[entry.first] = entry.second;
+}
+
+const Sprite& SpriteSheet::get(const string &name) const {
+    auto found = sprites.find(name);
+    if (found == sprites.end())
+        throw out_of_range("no sprite " + name);
+    return found->second;
+}
+
+bool SpriteSheet::has(const string &name) const {
+    return sprites.find(name) != sprites.end();
+}
+
+int SpriteSheet::size() const {
+    return sprites.size();
+}
+
+/*
+ * Each sprite is hashed by stamping it onto a pixel matrix of its own size.
+ */
+uint64_t SpriteSheet::hash() const {
+    const uint64_t PRIME = 0x100000001b3;
+    uint64_t h = 0xcbf29ce484222325;
+    auto mix = [&h](uint64_t value) { h = (h ^ value) * PRIME; };
+    for (const auto &entry: sprites) {
+        for (char c: entry.first)
+            mix(static_cast<unsigned char>(c));
+        const Sprite &sprite = entry.second;
+        PixelMatrix pixels(sprite.getRowCount(), sprite.getColCount(), RGB::TRANSPARENT);
+        sprite.stamp(pixels, sprite.getAnchorRow(), sprite.getAnchorCol());
+        mix(sprite.getAnchorRow());
+        mix(sprite.getAnchorCol());
+        mix(pixels.hash());
+    }
+    return h;
+}
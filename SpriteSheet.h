@@ -0,0 +1,98 @@
+/**
+ * @file SpriteSheet.h - named sprites, read from a text file
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include "Sprite.h"
+
+/**
+ * @class SpriteSheet - what the critters look like
+ *
+ * Sprites are parsed from text once (at startup, typically) and then looked up by
+ * name. A critter looks up the sprite for each of its poses and stamps it in render(),
+ * so a new kind of critter needs a few lines in a sprite sheet, not new render code.
+ * (The built-in critters have fixed shapes, so theirs are compile-time tables
+ * instead; see Shape.h.)
+ *
+ * The format is line-oriented; blank lines and lines starting with # are ignored:
+ *
+ *     color O 255 128 0           define pixel letter O (R, G, B)
+ *     sprite cannon 1 1           start sprite "cannon"; its anchor is at row 1, column 1
+ *     .R.                         one line per row of pixels, all the same length,
+ *     RRR                         . is transparent, letters are colors
+ *     end                         end of the sprite
+ *
+ * The letters K W R G B Y C M are predefined as RGB::BLACK, WHITE, RED, GREEN,
+ * BLUE, YELLOW, CYAN, and MAGENTA. A color definition lasts until the end of the
+ * text being parsed.
+ *
+ * Sprites are never moved or removed: parsing a sprite with the name of one already
+ * in the sheet replaces it in place. So a reference from get() stays good for
+ * the life of the sheet, and critters can hold on to theirs.
+ */
+class SpriteSheet {
+public:
+    SpriteSheet();
+
+    /**
+     * Get the sheet that sprite-driven critters render from (main loads --sprites files into it).
+     *
+     * @return  the standard sprite sheet
+     */
+    static SpriteSheet& standard();
+
+    /**
+     * Add the sprites from a sprite sheet file (replacing any with the same names).
+     *
+     * @param filename  sprite sheet file
+     * @throws          runtime_error if the file can't be read,
+     *                  invalid_argument if it isn't a valid sprite sheet
+     */
+    void load(const std::string &filename);
+
+    /**
+     * Add the sprites from sprite sheet text (replacing any with the same names).
+     *
+     * @param in      where to read the text from
+     * @param source  name of where the text came from (for error messages)
+     * @throws        invalid_argument if the text isn't a valid sprite sheet
+     */
+    void parse(std::istream &in, const std::string &source = "sprite sheet");
+
+    /**
+     * Look up a sprite.
+     *
+     * @param name  name of the sprite
+     * @return      the sprite (good for the life of this sheet)
+     * @throws      out_of_range if there's no sprite by that name
+     */
+    const Sprite& get(const std::string &name) const;
+
+    /**
+     * @param name  name of a sprite
+     * @return      true if there's a sprite by that name
+     */
+    bool has(const std::string &name) const;
+
+    /**
+     * @return  number of sprites in the sheet
+     */
+    int size() const;
+
+    /**
+     * Equal sheets (the same sprites by the same names) have equal hashes, so this
+     * is a cheap way to tell whether a recording was made with these sprites.
+     *
+     * @return  64-bit hash of the names, anchors, and pixels of every sprite
+     */
+    std::uint64_t hash() const;
+
+private:
+    std::map<std::string, Sprite> sprites;
+};
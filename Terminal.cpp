@@ -6,6 +6,8 @@
 
 #include <curses.h>
 #include <algorithm>
+#include <sys/ioctl.h>
+#include <unistd.h>
 #include "Terminal.h"
 using namespace std;
 
@@ -21,6 +23,8 @@ void Terminal::init(bool blockInGetKey) {
     }
     terminal = new _Terminal;
     terminal->refcount = 0;
+    terminal->lastFlush = 0.0;
+    terminal->flushed = chrono::steady_clock::now();
     cbreak();
     noecho();
     nonl();
@@ -97,7 +101,29 @@ void Terminal::paint(const PixelMatrix &pixels) {
             mvaddch(r, c, ' ');
             attroff(COLOR_PAIR(best));
         }
+    // time the flush -- a slow one means the tty can't keep up with us
+    auto start = chrono::steady_clock::now();
     refresh();
+    terminal->flushed = chrono::steady_clock::now();
+    terminal->lastFlush = chrono::duration<double>(terminal->flushed - start).count();
+}
+
+bool Terminal::isBacklogged() const {
+    if (getPendingOutput() > BACKLOG_BYTES)
+        return true;
+    // after a slow flush, give the tty as long again to drain before the next paint
+    if (terminal->lastFlush > BACKLOG_SECONDS) {
+        chrono::duration<double> sinceFlush = chrono::steady_clock::now() - terminal->flushed;
+        return sinceFlush.count() < terminal->lastFlush;
+    }
+    return false;
+}
+
+int Terminal::getPendingOutput() const {
+    int pending = 0;
+    if (ioctl(STDOUT_FILENO, TIOCOUTQ, &pending) < 0)
+        return 0;
+    return pending;
 }
 
 void Terminal::setText(int r, int c, const string &text) {
@@ -5,6 +5,7 @@
  */
 #pragma once
 #include <fstream>
+#include <chrono>
 #include "adt/Display.h"
 
 /**
@@ -64,6 +65,23 @@ public:
      */
     void paint(const PixelMatrix &pixels);
 
+    /**
+     * Check if the terminal is behind on output from earlier paints.
+     * We are behind if more than BACKLOG_BYTES are still sitting in the tty output
+     * queue, or if the last paint took longer than BACKLOG_SECONDS to flush and the
+     * tty hasn't yet had that long again to drain.
+     *
+     * @return true if painting now would add to an output backlog
+     */
+    bool isBacklogged() const;
+
+    /**
+     * Get the number of bytes written to the terminal but not yet sent by the tty driver.
+     *
+     * @return  pending output bytes (0 if the driver can't tell us)
+     */
+    int getPendingOutput() const;
+
     /**
      * Write some text onto the terminal.  White on black.
      *
@@ -111,10 +129,22 @@ public:
      */
     const ListA<RGB>& getColors() const;
 
+    /**
+     * more than this many bytes waiting in the tty output queue means we are backlogged
+     */
+    static const int BACKLOG_BYTES = 4096;
+
+    /**
+     * a paint that takes longer than this (in seconds) to flush means we are backlogged
+     */
+    static constexpr double BACKLOG_SECONDS = 0.050;
+
 private:
     struct _Terminal {
         int refcount;
         ListA<RGB> colors;
+        double lastFlush;  // seconds the last paint's refresh() took
+        std::chrono::steady_clock::time_point flushed;  // when the last paint's refresh() returned
     };
     static _Terminal *terminal;  // all the instances of Terminal share this one internal object
 
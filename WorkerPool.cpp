@@ -0,0 +1,109 @@
+/**
+ * @file WorkerPool.cpp - implementation of WorkerPool
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <algorithm>
+#include "WorkerPool.h"
+using namespace std;
+
+WorkerPool::WorkerPool(int threadCount) : threads(), lock(), wake(), finished(), body(nullptr), n(0), chunk(1),
+                                          chunkCount(0), nextChunk(0), chunksDone(0), busy(0), loop(0), stopping(false),
+                                          failure() {
+    if (threadCount <= 0)
+        threadCount = max(1, static_cast<int>(thread::hardware_concurrency()));
+    for (int i = 1; i < threadCount; i++)
+        threads.emplace_back(&WorkerPool::work, this);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread &t: threads)
+        t.join();
+}
+
+int WorkerPool::getThreadCount() const {
+    return static_cast<int>(threads.size()) + 1;
+}
+
+/*
+ * The caller works on chunks too, then waits for the workers. It waits until no worker
+ * is in the loop at all (not just until all the chunks are done), so none of them can
+ * still be looking at this loop's body when the next one starts.
+ */
+void WorkerPool::parallelFor(int n, int chunk, const Body &body) {
+    if (n <= 0)
+        return;
+    chunk = max(1, chunk);
+    if (threads.empty() || n <= chunk) {
+        for (int begin = 0; begin < n; begin += chunk)
+            body(begin, min(n, begin + chunk));
+        return;
+    }
+    {
+        unique_lock<mutex> guard(lock);
+        // a worker that overslept the last loop could still be on its way out of it
+        finished.wait(guard, [this] { return busy == 0; });
+        this->body = &body;
+        this->n = n;
+        this->chunk = chunk;
+        chunkCount = (n + chunk - 1) / chunk;
+        nextChunk.store(0);
+        chunksDone = 0;
+        failure = nullptr;
+        loop++;
+    }
+    wake.notify_all();
+    int done = runChunks();
+    unique_lock<mutex> guard(lock);
+    chunksDone += done;
+    finished.wait(guard, [this] { return chunksDone == chunkCount && busy == 0; });
+    this->body = nullptr;
+    if (failure)
+        rethrow_exception(failure);
+}
+
+/*
+ * Grab chunks until there are none left.
+ */
+int WorkerPool::runChunks() {
+    int done = 0;
+    for (int k; (k = nextChunk.fetch_add(1)) < chunkCount; done++) {
+        int begin = k * chunk;
+        try {
+            (*body)(begin, min(n, begin + chunk));
+        } catch (...) {
+            lock_guard<mutex> guard(lock);
+            if (!failure)
+                failure = current_exception();
+        }
+    }
+    return done;
+}
+
+void WorkerPool::work() {
+    long seen = 0;
+    for (;;) {
+        {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [&] { return stopping || loop != seen; });
+            if (stopping)
+                return;
+            seen = loop;
+            busy++;
+        }
+        int done = runChunks();
+        {
+            lock_guard<mutex> guard(lock);
+            chunksDone += done;
+            busy--;
+            if (busy == 0)
+                finished.notify_one();
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/**
+ * @file WorkerPool.h - fixed set of threads for running loops in parallel
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkerPool - runs the chunks of a loop on several threads at once
+ *
+ * parallelFor splits 0...n-1 into chunks of a fixed size and hands them out to
+ * the worker threads and the calling thread, returning when all of them are done.
+ * The chunks depend only on n and the chunk size (never on the number of threads
+ * or on timing), so a loop body that only writes to its own indices gets exactly
+ * the same results no matter how many threads there are.
+ *
+ * A pool of 1 thread has no worker threads and just runs the loop in the caller.
+ * parallelFor is not reentrant: call it from one thread at a time and not from
+ * inside a loop body.
+ */
+class WorkerPool {
+public:
+    /**
+     * Loop body: do the indices from begin up to (not including) end.
+     */
+    typedef std::function<void(int begin, int end)> Body;
+
+    /**
+     * @param threadCount  number of threads to run loops on, including the caller's
+     *                     (0 means one per hardware thread)
+     */
+    explicit WorkerPool(int threadCount = 0);
+
+    /**
+     * Stops and joins the worker threads.
+     */
+    ~WorkerPool();
+    WorkerPool(const WorkerPool &other) = delete;
+    WorkerPool& operator=(const WorkerPool &other) = delete;
+
+    /**
+     * Run body over 0...n-1 in chunks, in parallel.
+     *
+     * @param n      number of indices
+     * @param chunk  number of indices per chunk (the last one may be short)
+     * @param body   loop body, called once per chunk
+     * @throws       whatever the body threw (the first one, if several chunks threw),
+     *               once all the chunks are done
+     */
+    void parallelFor(int n, int chunk, const Body &body);
+
+    /**
+     * @return  number of threads loops run on, including the caller's
+     */
+    int getThreadCount() const;
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex lock;
+    std::condition_variable wake;       // a new loop has started (or we are stopping)
+    std::condition_variable finished;   // the last worker has left a loop
+    const Body *body;                   // loop being run
+    int n, chunk, chunkCount;
+    std::atomic<int> nextChunk;         // next chunk to hand out
+    int chunksDone;
+    int busy;                           // number of workers in the current loop
+    long loop;                          // counts loops started, so workers know there's a new one
+    bool stopping;
+    std::exception_ptr failure;
+
+    void work();
+    int runChunks();
+};
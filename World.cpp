@@ -0,0 +1,84 @@
+/**
+ * @file World.cpp - implementation of World
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include "World.h"
+using namespace std;
+
+World::World(int rows, int cols) : rows(rows), cols(cols), chunks() {
+    if (rows <= 0 || cols <= 0)
+        throw invalid_argument("world must have positive dimensions");
+}
+
+int World::getRowCount() const {
+    return rows;
+}
+
+int World::getColCount() const {
+    return cols;
+}
+
+uint64_t World::key(int chunkRow, int chunkCol) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(chunkRow)) << 32 | static_cast<uint32_t>(chunkCol);
+}
+
+bool World::overlaps(int top, int left, int bottom, int right) const {
+    return top < rows && bottom >= 0 && left < cols && right >= 0 && top <= bottom && left <= right;
+}
+
+void World::clear() {
+    for (auto chunk = chunks.begin(); chunk != chunks.end(); ) {
+        if (chunk->second.size() == 0) {
+            chunk = chunks.erase(chunk);
+        } else {
+            chunk->second.clear();
+            ++chunk;
+        }
+    }
+}
+
+void World::add(int id, int top, int left, int bottom, int right) {
+    if (!overlaps(top, left, bottom, right))
+        return;
+    int firstRow = max(top, 0) / CHUNK, lastRow = min(bottom, rows - 1) / CHUNK;
+    int firstCol = max(left, 0) / CHUNK, lastCol = min(right, cols - 1) / CHUNK;
+    for (int r = firstRow; r <= lastRow; r++)
+        for (int c = firstCol; c <= lastCol; c++)
+            chunks[key(r, c)].append(id);
+}
+
+void World::query(int top, int left, int bottom, int right, ListA<int> &out) const {
+    if (!overlaps(top, left, bottom, right))
+        return;
+    int start = out.size();
+    int firstRow = max(top, 0) / CHUNK, lastRow = min(bottom, rows - 1) / CHUNK;
+    int firstCol = max(left, 0) / CHUNK, lastCol = min(right, cols - 1) / CHUNK;
+    for (int r = firstRow; r <= lastRow; r++)
+        for (int c = firstCol; c <= lastCol; c++) {
+            auto chunk = chunks.find(key(r, c));
+            if (chunk != chunks.end())
+                for (int id: chunk->second)
+                    out.append(id);
+        }
+
+    // something that straddles chunks was found once for each of them
+    sort(out.begin() + start, out.end());
+    int kept = unique(out.begin() + start, out.end()) - out.begin();
+    while (out.size() > kept)
+        out.remove();
+}
+
+int World::getActiveChunkCount() const {
+    return chunks.size();
+}
+
+size_t World::getBytesReserved() const {
+    size_t bytes = chunks.bucket_count() * sizeof(void *);
+    for (const auto &chunk: chunks)
+        bytes += sizeof(chunk) + chunk.second.getCapacity() * sizeof(int);
+    return bytes;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file World.h - playing field bigger than the display, indexed in chunks
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC 2430, Spring 2018"
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include "ListA.h"
+
+/**
+ * @class World - where the critters live when that's more than fits on the display
+ *
+ * The world is rows by cols cells, divided into CHUNK by CHUNK square chunks.
+ * Each frame, every critter is added to the chunks its bounds overlap, and then
+ * query finds the ones that might be in a rectangle (the viewport the display
+ * shows, say) by looking in just the chunks that rectangle overlaps, rather
+ * than at every critter.
+ *
+ * Only chunks that have had a critter in them lately take up any memory: clear
+ * drops the ones that were empty for a whole frame, so memory follows the
+ * critters, not the size of the world.
+ */
+class World {
+public:
+    /**
+     * side of a chunk, in cells
+     */
+    static const int CHUNK = 32;
+
+    /**
+     * @param rows  number of rows in the world
+     * @param cols  number of columns in the world
+     * @throws      invalid_argument if either is not positive
+     */
+    World(int rows, int cols);
+
+    int getRowCount() const;
+    int getColCount() const;
+
+    /**
+     * Check if a rectangle is at least partly inside the world.
+     *
+     * @param top     topmost row (inclusive)
+     * @param left    leftmost column (inclusive)
+     * @param bottom  bottommost row (inclusive)
+     * @param right   rightmost column (inclusive)
+     * @return        true if any cell of it is in the world
+     */
+    bool overlaps(int top, int left, int bottom, int right) const;
+
+    /**
+     * Empty all the chunks for a new frame, dropping any that were empty all last frame.
+     */
+    void clear();
+
+    /**
+     * Put something in every chunk its bounds overlap (parts outside the world are ignored).
+     *
+     * @param id      what to put there (a critter's index, say)
+     * @param top     topmost row (inclusive)
+     * @param left    leftmost column (inclusive)
+     * @param bottom  bottommost row (inclusive)
+     * @param right   rightmost column (inclusive)
+     */
+    void add(int id, int top, int left, int bottom, int right);
+
+    /**
+     * Find everything added to a chunk the rectangle overlaps. Those are the only
+     * ones that might overlap the rectangle (the caller checks their actual bounds).
+     *
+     * @param top     topmost row (inclusive)
+     * @param left    leftmost column (inclusive)
+     * @param bottom  bottommost row (inclusive)
+     * @param right   rightmost column (inclusive)
+     * @param out     where to append the ids: each one once, in increasing order
+     */
+    void query(int top, int left, int bottom, int right, ListA<int> &out) const;
+
+    /**
+     * @return  number of chunks taking up memory
+     */
+    int getActiveChunkCount() const;
+
+    /**
+     * @return  bytes held by the chunks (roughly)
+     */
+    std::size_t getBytesReserved() const;
+
+private:
+    int rows, cols;
+    std::unordered_map<std::uint64_t, ListA<int>> chunks;  // by key(chunk row, chunk column)
+
+    static std::uint64_t key(int chunkRow, int chunkCol);
+};
@@ -5,8 +5,10 @@
  */
 
 #pragma once
+#include <cstdint>
 #include "Printable.h"
 #include "../PixelMatrix.h"
+#include "../CritterPool.h"
 
 /**
  * @class Critter ADT - for menagerie game
@@ -48,6 +50,68 @@ public:
      */
     virtual void render(PixelMatrix &pxm) const = 0;
 
+    /**
+     * View of just part of the critter, for drawing in tiles, bands, or a viewport.
+     * Only the pixels inside the clip rectangle have to be painted, so a critter can
+     * skip the rest, or skip rendering altogether if it is nowhere near. The rectangle
+     * is in the same coordinates render() paints in; the matrix's origin (see
+     * PixelMatrix::setOrigin) says where they land in it, so pxm can be just the
+     * size of the clip rectangle.
+     *
+     * Pixels outside the rectangle may get painted, too, so callers should look only
+     * inside it. The default renders the whole critter unless its bounds (see getBounds)
+     * miss the rectangle.
+     *
+     * @param pxm     pixel map to paint with the rendering of this critter
+     * @param top     topmost row to paint (inclusive)
+     * @param left    leftmost column to paint (inclusive)
+     * @param bottom  bottommost row to paint (inclusive)
+     * @param right   rightmost column to paint (inclusive)
+     */
+    virtual void renderClipped(PixelMatrix &pxm, int top, int left, int bottom, int right) const {
+        int t, l, b, r;
+        if (getBounds(t, l, b, r) && (t > bottom || b < top || l > right || r < left))
+            return;
+        render(pxm);
+    }
+
+    /**
+     * Get the smallest rectangle that render() paints inside of, if the critter knows
+     * it. Then callers can look at just that part of a rendering instead of all of it.
+     *
+     * @param top     returned by reference: topmost row painted
+     * @param left    returned by reference: leftmost column painted
+     * @param bottom  returned by reference: bottommost row painted
+     * @param right   returned by reference: rightmost column painted
+     * @return        false if the critter doesn't know (its rendering could be anywhere)
+     */
+    virtual bool getBounds(int & /* top */, int & /* left */, int & /* bottom */, int & /* right */) const {
+        return false;
+    }
+
+    /**
+     * @struct State - a critter's whole data model as plain data, for snapshots
+     * (see Snapshot, which also has the kinds and makes critters back from their State)
+     */
+    struct State {
+        std::uint8_t kind;      // which class of critter, a Snapshot::Kind
+        std::uint8_t heading;   // a Direction
+        std::uint8_t phase;     // depends on kind, e.g., whether an InchWorm is bunched
+        std::uint8_t unused;
+        std::int32_t row, col;
+    };
+
+    /**
+     * Get this critter's data model as plain data, so it can be snapshotted and
+     * made again later (with Snapshot::make).
+     *
+     * @param state  returned by reference: the critter's state
+     * @return       false if this kind of critter can't be snapshotted
+     */
+    virtual bool getState(State & /* state */) const {
+        return false;
+    }
+
     /**
      * Get the current heading (which way the next move() will take this).
      *
@@ -84,6 +148,27 @@ public:
     }
 
     virtual ~Critter() {} // make the destructors virtual
+
+    /**
+     * Critters are allocated from CritterPool::instance() rather than the general heap.
+     *
+     * @param size  size of the critter (of the most-derived class)
+     * @return      memory for it
+     */
+    static void *operator new(std::size_t size) {
+        return CritterPool::instance().allocate(size);
+    }
+
+    /**
+     * Give a critter's memory back to the pool. The virtual destructor makes sure
+     * size is that of the most-derived class, matching what operator new got.
+     *
+     * @param p     the critter's memory
+     * @param size  size of the critter (of the most-derived class)
+     */
+    static void operator delete(void *p, std::size_t size) {
+        CritterPool::instance().deallocate(p, size);
+    }
 };
 
 
@@ -46,6 +46,17 @@ public:
      */
     virtual void paint(const PixelMatrix &pixels) = 0;
 
+    /**
+     * Check if the display is still working off the output from earlier paints
+     * (e.g., a slow terminal or ssh connection). Anything painted now would only
+     * show up after everything already queued, so callers that paint continuously
+     * should skip frames while this is true.
+     * Displays that never fall behind can use this default.
+     *
+     * @return true if painting now would add to an output backlog
+     */
+    virtual bool isBacklogged() const { return false; }
+
     /**
      * Write some text onto the display.
      *
@@ -2,15 +2,229 @@
  * @file p1.cpp - driver for the menagerie game
  * @author Prof. Kevin Lundeen
  * @see "Seattle University, CPSC 2430, Spring 2018"
+ *
+ * Usage:
+ *     menagerie [--record FILE [--hash]]   play three games (optionally recording them)
+ *     menagerie --replay FILE              replay a recording headless at full speed
+ *     menagerie --broadcast SOCKET         also send the games to spectators connecting to SOCKET
+ *     menagerie --shared NAME              play in POSIX shared memory NAME instead of the terminal
+ *     menagerie --threads N                move and render critters on N threads
+ *     menagerie --sprites FILE             load sprites for sprite-driven critters from FILE (see SpriteSheet.h)
+ *     menagerie --scenario FILE            play the waves of critters in FILE instead (see Scenario.h)
+ *     menagerie --swarm N [--frames F]     benchmark a game of N extra worms headless for F frames (default 100)
+ *     menagerie --bot APM                  let a bot play, at APM keystrokes a minute (with --swarm, a scene is 1/30s;
+ *                                          not with --world, since the bot can only see the display)
+ *     menagerie --world ROWS COLS          play in a world of ROWS x COLS, the display following the cannon
+ *                                          (with --swarm, the worms fill the world and the display is 24x80)
+ *     menagerie --read-log FILE            print a debug log (dbug.log, from a -DMENAGERIE_LOG_LEVEL=DEBUG build) as text
+ *     menagerie --allocs                   count allocations by subsystem (with --swarm, report them per frame)
+ *     menagerie --self-check               run quick checks of the containers, snapshots, threads, and replays
  */
 
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <chrono>
+#include <string>
 #include "Menagerie.h"
+#include "Logger.h"
 #include "Terminal.h"
+#include "Headless.h"
+#include "Autoplayer.h"
+#include "Recording.h"
+#include "Broadcast.h"
+#include "SharedDisplay.h"
+#include "Scenario.h"
+#include "SelfCheck.h"
+#include "SpriteSheet.h"
+using namespace std;
 
-int main() {
-    Terminal t(false);  // false -> don't block on keystrokes
-    Menagerie game(t);
-    for (int i = 0; i < 3; i++)
+/*
+ * Replay every game in the recording and report how long it took and whether it matched.
+ */
+int replay(const string &filename, int threads, const Scenario *scenario, int worldRows, int worldCols) {
+    Replay replay(filename);
+    Headless h(replay.getRowCount(), replay.getColCount());
+    Menagerie game(h);
+    game.setThreadCount(threads);
+    game.setScenario(scenario);
+    game.setWorld(worldRows, worldCols);
+    game.replay(&replay);
+    int games = 0;
+    auto start = chrono::steady_clock::now();
+    while (replay.hasGame()) {
         game.play();
+        games++;
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << filename << ": " << games << " games, " << h.getPaintCount() << " paints in "
+         << elapsed.count() << "s, " << game.getReplayMismatches() << " mismatches" << endl;
+    return game.getReplayMismatches() == 0 ? 0 : 1;
+}
+
+/*
+ * Play one swarm-mode game headless (nobody playing) on a display big enough for
+ * all the worms (or a standard-size one onto a world, if given), and report where
+ * the time and the memory went.
+ */
+int swarm(int count, int frames, int threads, const Scenario *scenario, int worldRows, int worldCols, int apm) {
+    int rows = max(24, static_cast<int>(ceil(sqrt(12.0 * count))) + 4);
+    int cols = 4 * rows;
+    if (worldRows > 0) {
+        rows = 24;
+        cols = 80;
+    }
+    Headless h(rows, cols);
+    Autoplayer *bot = apm > 0 ? new Autoplayer(h, apm, 1.0 / 30) : nullptr;
+    Menagerie game(bot != nullptr ? static_cast<Display&>(*bot) : h);
+    game.setThreadCount(threads);
+    game.setScenario(scenario);
+    game.setWorld(worldRows, worldCols);
+    game.setSwarm(count);
+    game.setFrameLimit(frames);
+    auto start = chrono::steady_clock::now();
+    game.play();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    const Menagerie::FrameStats &stats = game.getFrameStats();
+    cout << "swarm of " << count << " on " << rows << "x" << cols;
+    if (worldRows > 0)
+        cout << " in a world of " << worldRows << "x" << worldCols;
+    cout << " with " << threads << " thread(s): "
+         << stats.frames << " frames in " << elapsed.count() << "s" << endl;
+    game.printFrameStats(cout);
+    if (bot != nullptr)
+        cout << "bot: " << bot->getActionCount() << " keystrokes, " << bot->getShotCount() << " shots" << endl;
+    game.printFootprint(cout);
+    delete bot;
+    return 0;
+}
+
+/*
+ * stoi, but a bad number says what it was
+ */
+int toInt(const string &text) {
+    size_t used = 0;
+    int n = 0;
+    try {
+        n = stoi(text, &used);
+    } catch (const logic_error &) {
+        used = 0;
+    }
+    if (used == 0 || used != text.size())
+        throw invalid_argument("not a number: " + text);
+    return n;
+}
+
+/*
+ * Say how to run the program.
+ */
+void usage(const char *program) {
+    cerr << "usage: " << program << " [--record FILE [--hash]] [--broadcast SOCKET] [--shared NAME] [--sprites FILE] [--scenario FILE] [--threads N] [--bot APM] [--world ROWS COLS] [--allocs] | --replay FILE | --swarm N [--frames F] | --read-log FILE | --self-check" << endl;
+}
+
+int main(int argc, char *argv[]) {
+    Display *screen = nullptr;
+    Broadcast *broadcast = nullptr;
+    Autoplayer *bot = nullptr;
+    Recorder *recorder = nullptr;
+    try {
+        string recordFile, replayFile, socketPath, sharedName;
+        bool hashFrames = false;
+        int threads = 1;
+        int swarmSize = 0, frames = 100;
+        int worldRows = 0, worldCols = 0;
+        int apm = 0;
+        Scenario scenario;
+        bool scenarioLoaded = false;
+        for (int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            if (arg == "--record" && i + 1 < argc)
+                recordFile = argv[++i];
+            else if (arg == "--replay" && i + 1 < argc)
+                replayFile = argv[++i];
+            else if (arg == "--broadcast" && i + 1 < argc)
+                socketPath = argv[++i];
+            else if (arg == "--shared" && i + 1 < argc)
+                sharedName = argv[++i];
+            else if (arg == "--sprites" && i + 1 < argc)
+                SpriteSheet::standard().load(argv[++i]);
+            else if (arg == "--threads" && i + 1 < argc)
+                threads = toInt(argv[++i]);
+            else if (arg == "--scenario" && i + 1 < argc) {
+                scenario.load(argv[++i]);
+                scenarioLoaded = true;
+            } else if (arg == "--swarm" && i + 1 < argc) {
+                swarmSize = toInt(argv[++i]);
+                if (swarmSize <= 0)
+                    throw invalid_argument("--swarm needs at least one worm");
+            } else if (arg == "--frames" && i + 1 < argc) {
+                frames = toInt(argv[++i]);
+                if (frames <= 0)
+                    throw invalid_argument("--frames needs at least one frame");
+            } else if (arg == "--bot" && i + 1 < argc) {
+                apm = toInt(argv[++i]);
+                if (apm <= 0)
+                    throw invalid_argument("--bot needs at least one keystroke a minute");
+            } else if (arg == "--world" && i + 2 < argc) {
+                worldRows = toInt(argv[++i]);
+                worldCols = toInt(argv[++i]);
+            }
+            else if (arg == "--hash")
+                hashFrames = true;
+            else if (arg == "--allocs")
+                Allocations::setEnabled(true);
+            else if (arg == "--read-log" && i + 1 < argc) {
+                Logger::decode(argv[++i], cout);
+                return 0;
+            }
+            else if (arg == "--self-check")
+                return selfCheck(cout) == 0 ? 0 : 1;
+            else {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        if (apm > 0 && (worldRows > 0 || worldCols > 0))
+            throw invalid_argument("--bot can't play with --world: it only sees the display, not the critters up in the world");
+        const Scenario *waves = scenarioLoaded ? &scenario : nullptr;
+        if (!replayFile.empty())
+            return replay(replayFile, threads, waves, worldRows, worldCols);
+        if (swarmSize > 0)
+            return swarm(swarmSize, frames, threads, waves, worldRows, worldCols, apm);
+
+        if (!sharedName.empty())
+            screen = new SharedDisplay(sharedName);
+        else
+            screen = new Terminal(false);  // false -> don't block on keystrokes
+        if (!socketPath.empty())
+            broadcast = new Broadcast(*screen, socketPath);
+        Display *player = broadcast != nullptr ? static_cast<Display*>(broadcast) : screen;
+        if (apm > 0)
+            player = bot = new Autoplayer(*player, apm);
+        Menagerie game(*player);
+        game.setThreadCount(threads);
+        game.setScenario(waves);
+        game.setWorld(worldRows, worldCols);
+        if (!recordFile.empty())
+            recorder = new Recorder(recordFile, screen->getRowCount(), screen->getColCount(), game.getSettings(), hashFrames);
+        game.record(recorder);
+        for (int i = 0; i < 3; i++)
+            game.play();
+        game.record(nullptr);
+    } catch (const exception &e) {
+        delete recorder;
+        delete bot;
+        delete broadcast;
+        delete screen;  // gives the terminal back before saying what went wrong
+        cerr << argv[0] << ": " << e.what() << endl;
+        usage(argv[0]);
+        return 2;
+    }
+    delete recorder;
+    delete bot;
+    delete broadcast;
+    delete screen;
     return 0;
-}
\ No newline at end of file
+}